@@ -42,6 +42,10 @@ HEADERS += \
     qivipagingmodel.h \
     qivipagingmodel_p.h \
     qivipagingmodelinterface.h \
+    qivipagingmodelstatistics.h \
+    qivipagingmodelstatistics_p.h \
+    qivichunkcache_p.h \
+    qiviutils_p.h \
     qivisearchandbrowsemodel.h \
     qivisearchandbrowsemodel_p.h \
     qivisearchandbrowsemodelinterface.h \
@@ -66,6 +70,9 @@ SOURCES += \
     qiviabstractfeaturelistmodel.cpp \
     qivipagingmodel.cpp \
     qivipagingmodelinterface.cpp \
+    qivipagingmodelstatistics.cpp \
+    qivichunkcache.cpp \
+    qiviutils.cpp \
     qivisearchandbrowsemodel.cpp \
     qivisearchandbrowsemodelinterface.cpp \
     qivistandarditem.cpp \
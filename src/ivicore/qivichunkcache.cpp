@@ -0,0 +1,196 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#include "qivichunkcache_p.h"
+
+QT_BEGIN_NAMESPACE
+
+QIviChunkCache::QIviChunkCache(const QVector<QVariant> *rows, const int *chunkSize, const EvictFunction &evict)
+    : m_rows(rows)
+    , m_chunkSize(chunkSize)
+    , m_evict(evict)
+    , m_cacheLimit(0)
+    , m_cachedChunkCount(0)
+    , m_accessCounter(0)
+{
+}
+
+int QIviChunkCache::cacheLimit() const
+{
+    return m_cacheLimit;
+}
+
+void QIviChunkCache::setCacheLimit(int cacheLimit)
+{
+    m_cacheLimit = cacheLimit;
+    evictChunks();
+}
+
+int QIviChunkCache::cachedChunkCount() const
+{
+    return m_cachedChunkCount;
+}
+
+int QIviChunkCache::chunkCount() const
+{
+    return m_availableChunks.count();
+}
+
+void QIviChunkCache::resize(int chunkCount)
+{
+    m_availableChunks.resize(chunkCount);
+}
+
+//Returns true if the rows of the chunk exist, but need to be fetched
+bool QIviChunkCache::isChunkMissing(int chunkIndex) const
+{
+    return chunkIndex >= 0 && chunkIndex < m_availableChunks.count() && !m_availableChunks.at(chunkIndex);
+}
+
+void QIviChunkCache::setChunkAvailable(int chunkIndex, bool available)
+{
+    if (chunkIndex >= 0 && chunkIndex < m_availableChunks.count())
+        m_availableChunks.setBit(chunkIndex, available);
+}
+
+void QIviChunkCache::cacheChunk(int chunkIndex)
+{
+    if (chunkIndex >= m_chunkAccess.count())
+        m_chunkAccess.resize(chunkIndex + 1);
+
+    if (!m_chunkAccess.at(chunkIndex))
+        m_cachedChunkCount++;
+    m_chunkAccess[chunkIndex] = ++m_accessCounter;
+
+    evictChunks();
+}
+
+void QIviChunkCache::touchChunk(int chunkIndex) const
+{
+    if (chunkIndex < 0 || chunkIndex >= m_chunkAccess.count() || !m_chunkAccess.at(chunkIndex))
+        return;
+
+    m_chunkAccess[chunkIndex] = ++m_accessCounter;
+}
+
+void QIviChunkCache::evictChunks()
+{
+    if (m_cacheLimit <= 0)
+        return;
+
+    while (m_cachedChunkCount > m_cacheLimit) {
+        //Find the least recently used chunk. The chunk which was just fetched always has the
+        //newest access stamp and will never be evicted here.
+        int lruChunk = -1;
+        for (int i = 0; i < m_chunkAccess.count(); i++) {
+            const quint64 access = m_chunkAccess.at(i);
+            if (access && (lruChunk == -1 || access < m_chunkAccess.at(lruChunk)))
+                lruChunk = i;
+        }
+
+        if (lruChunk == -1)
+            return;
+
+        evictChunk(lruChunk);
+    }
+}
+
+void QIviChunkCache::evictChunk(int chunkIndex)
+{
+    //Clearing the bit makes the model fetch the chunk again once it is needed
+    if (chunkIndex < m_availableChunks.count())
+        m_availableChunks.clearBit(chunkIndex);
+
+    m_chunkAccess[chunkIndex] = 0;
+    m_cachedChunkCount--;
+
+    const int start = chunkIndex * *m_chunkSize;
+    m_evict(chunkIndex, start, qMin(start + *m_chunkSize, m_rows->count()));
+}
+
+void QIviChunkCache::updateAvailability(int fromRow)
+{
+    //Inserting or removing rows shifts all following rows into other chunks. Only the chunks which
+    //still have all their rows are kept, all others will be fetched again once they are needed.
+    const int chunkSize = *m_chunkSize;
+    const int chunkCount = (m_rows->count() + chunkSize - 1) / chunkSize;
+    m_availableChunks.resize(chunkCount);
+
+    for (int i = chunkCount; i < m_chunkAccess.count(); i++) {
+        if (m_chunkAccess.at(i))
+            m_cachedChunkCount--;
+    }
+    if (m_chunkAccess.count() > chunkCount)
+        m_chunkAccess.resize(chunkCount);
+
+    for (int chunkIndex = fromRow / chunkSize; chunkIndex < chunkCount; chunkIndex++) {
+        const int start = chunkIndex * chunkSize;
+        const int end = qMin(start + chunkSize, m_rows->count());
+        bool available = true;
+        for (int i = start; i < end && available; i++)
+            available = m_rows->at(i).isValid();
+
+        m_availableChunks.setBit(chunkIndex, available);
+        const bool cached = chunkIndex < m_chunkAccess.count() && m_chunkAccess.at(chunkIndex);
+        if (available && !cached) {
+            cacheChunk(chunkIndex);
+        } else if (!available && cached) {
+            m_chunkAccess[chunkIndex] = 0;
+            m_cachedChunkCount--;
+        }
+    }
+}
+
+void QIviChunkCache::rebuild()
+{
+    //The chunk indexes changed, recalculate all of them from the available rows
+    clear();
+    updateAvailability(0);
+}
+
+void QIviChunkCache::clear()
+{
+    m_availableChunks.clear();
+    m_chunkAccess.clear();
+    m_cachedChunkCount = 0;
+}
+
+QT_END_NAMESPACE
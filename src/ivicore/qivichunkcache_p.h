@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#ifndef QIVICHUNKCACHE_P_H
+#define QIVICHUNKCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtiviglobal_p.h>
+
+#include <QBitArray>
+#include <QVariant>
+#include <QVector>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+//Keeps track of which chunks of a paged model are loaded and evicts the least recently used ones
+//once more than cacheLimit chunks are loaded. The rows and the chunk size are owned by the model.
+class Q_QTIVICORE_EXPORT QIviChunkCache
+{
+public:
+    //Called to drop the rows from start to end - 1 of an evicted chunk
+    typedef std::function<void(int chunkIndex, int start, int end)> EvictFunction;
+
+    QIviChunkCache(const QVector<QVariant> *rows, const int *chunkSize, const EvictFunction &evict);
+
+    int cacheLimit() const;
+    void setCacheLimit(int cacheLimit);
+    int cachedChunkCount() const;
+
+    int chunkCount() const;
+    void resize(int chunkCount);
+    bool isChunkMissing(int chunkIndex) const;
+    void setChunkAvailable(int chunkIndex, bool available = true);
+
+    void cacheChunk(int chunkIndex);
+    void touchChunk(int chunkIndex) const;
+    void evictChunks();
+    void updateAvailability(int fromRow);
+    void rebuild();
+    void clear();
+
+private:
+    void evictChunk(int chunkIndex);
+
+    const QVector<QVariant> *m_rows;
+    const int *m_chunkSize;
+    EvictFunction m_evict;
+    QBitArray m_availableChunks;
+    int m_cacheLimit;
+    int m_cachedChunkCount;
+    mutable quint64 m_accessCounter;
+    mutable QVector<quint64> m_chunkAccess;
+};
+
+QT_END_NAMESPACE
+
+#endif // QIVICHUNKCACHE_P_H
@@ -44,19 +44,201 @@
 #include "qivipagingmodel_p.h"
 
 #include "qivipagingmodelinterface.h"
+#include "qivipagingmodelstatistics_p.h"
 #include "qiviqmlconversion_helper.h"
+#include "qiviutils_p.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
 #include <QDebug>
+#include <QDir>
+#include <QFileInfo>
 #include <QMetaObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
+Q_LOGGING_CATEGORY(qLcIviPagingModel, "qt.ivi.pagingmodel");
+
+namespace qtivi_helper {
+    //The time a single fetch should take at most when adapting the chunk size, in milliseconds
+    static const qreal fetchLatencyBudget = 100;
+    //The number of recent fetches used to estimate the latency and the cost per row
+    static const int fetchSampleCount = 16;
+    //Identifies a snapshot file and the version of its format
+    static const quint32 snapshotMagic = 0x51495053;
+    static const quint32 snapshotVersion = 1;
+    //The time the snapshot writes are collected, before the snapshot file is written at once
+    static const int snapshotDelay = 1000;
+
+    //All shared caches of the process, indexed by the key of the query they belong to
+    typedef QHash<QString, QIviPagingModelSharedCache *> SharedCacheHash;
+    Q_GLOBAL_STATIC(SharedCacheHash, sharedCaches)
+
+    //A single thread decodes the fetched chunks, which keeps them in the order they arrived
+    Q_GLOBAL_STATIC(QThreadPool, decodeThreadPool)
+    //A single thread writes the snapshots, which keeps the writes of a file in order
+    Q_GLOBAL_STATIC(QThreadPool, snapshotThreadPool)
+}
+
+using namespace qtivi_helper;
+
+//Lives in the thread of the model and receives the decoded chunks. The decode tasks share its
+//ownership, which makes it safe to delete the model while a chunk is decoded.
+class QIviPagingModelDecodeRelay : public QObject
+{
+public:
+    explicit QIviPagingModelDecodeRelay(QIviPagingModelPrivate *model)
+        : m_model(model)
+    {}
+
+    QIviPagingModelPrivate *m_model;
+};
+
+class QIviPagingModelDecodeTask : public QRunnable
+{
+public:
+    QIviPagingModelDecodeTask(const QSharedPointer<QIviPagingModelDecodeRelay> &relay, const QList<QVariant> &items,
+                              const std::function<void(const QVector<QIviPagingModelPrivate::DecodedRow> &)> &handler)
+        : m_relay(relay)
+        , m_items(items)
+        , m_handler(handler)
+    {}
+
+    void run() override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        const QVector<QIviPagingModelPrivate::DecodedRow> rows = QIviPagingModelPrivate::decodeRows(m_items);
+        const qint64 decodeTime = timer.nsecsElapsed();
+
+        //Hand the ready rows to the model with a single queued call
+        const QSharedPointer<QIviPagingModelDecodeRelay> relay = m_relay;
+        const auto handler = m_handler;
+        QMetaObject::invokeMethod(relay.data(), [relay, handler, rows, decodeTime]() {
+            QIviPagingModelPrivate *model = relay->m_model;
+            if (!model)
+                return;
+
+            model->m_pendingDecodes--;
+            model->m_decodeTime += decodeTime;
+            const qint64 handOffStart = model->m_fetchTimer.nsecsElapsed();
+            const bool replaying = model->m_replayingDecoded;
+            model->m_replayingDecoded = true;
+            handler(rows);
+
+            //The model might have been deleted by a slot connected to one of its signals
+            model = relay->m_model;
+            if (!model)
+                return;
+            model->m_replayingDecoded = replaying;
+            model->m_decodedChunkCount++;
+            model->m_decodeHandOffTime += model->m_fetchTimer.nsecsElapsed() - handOffStart;
+            model->scheduleStatisticsUpdate();
+        }, Qt::QueuedConnection);
+    }
+
+private:
+    QSharedPointer<QIviPagingModelDecodeRelay> m_relay;
+    QList<QVariant> m_items;
+    std::function<void(const QVector<QIviPagingModelPrivate::DecodedRow> &)> m_handler;
+};
+
+//Serializes and writes a snapshot on a worker thread. It only works on copies of the rows, which
+//makes it independent of the model.
+class QIviPagingModelSnapshotTask : public QRunnable
+{
+public:
+    QIviPagingModelSnapshotTask(const QString &filePath, const QString &key, int loadingType, int totalCount,
+                                bool moreAvailable, const QVector<QVariant> &items)
+        : m_filePath(filePath)
+        , m_key(key)
+        , m_loadingType(loadingType)
+        , m_totalCount(totalCount)
+        , m_moreAvailable(moreAvailable)
+        , m_items(items)
+    {}
+
+    void run() override
+    {
+        QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+        QSaveFile file(m_filePath);
+        if (!file.open(QIODevice::WriteOnly)) {
+            qWarning() << "Couldn't write the snapshot" << m_filePath << ":" << file.errorString();
+            return;
+        }
+
+        QDataStream stream(&file);
+        stream.setVersion(QDataStream::Qt_5_12);
+        stream << snapshotMagic << snapshotVersion << m_key << m_loadingType << m_totalCount
+               << m_moreAvailable << m_items.count();
+
+        for (const QVariant &item : qAsConst(m_items)) {
+            stream << QByteArray(QMetaType::typeName(item.userType()));
+            //Without stream operators the items can't be stored at all
+            if (!QMetaType::save(stream, item.userType(), item.constData())) {
+                file.cancelWriting();
+                return;
+            }
+        }
+
+        file.commit();
+    }
+
+private:
+    QString m_filePath;
+    QString m_key;
+    int m_loadingType;
+    int m_totalCount;
+    bool m_moreAvailable;
+    QVector<QVariant> m_items;
+};
+
 QIviPagingModelPrivate::QIviPagingModelPrivate(const QString &interface, QIviPagingModel *model)
     : QIviAbstractFeatureListModelPrivate(interface, model)
     , q_ptr(model)
     , m_capabilities(QtIviCoreModule::NoExtras)
     , m_chunkSize(30)
+    , m_chunkCache(&m_itemList, &m_chunkSize, [this](int chunkIndex, int start, int end) {
+        evictChunk(chunkIndex, start, end);
+    })
     , m_moreAvailable(false)
+    , m_prefetchDistance(0)
+    , m_explicitViewport(false)
+    , m_viewportFirst(-1)
+    , m_viewportLast(-1)
+    , m_lastAccessedRow(-1)
+    , m_scrollDirection(0)
+    , m_cacheHits(0)
+    , m_cacheMisses(0)
+    , m_fetchCount(0)
+    , m_totalFetchLatency(0)
+    , m_fetchLatencyHistogram(QIviPagingModelStatisticsPrivate::latencyBuckets().count() + 1, 0)
+    , m_evictedChunkCount(0)
+    , m_statisticsEnabled(false)
+    , m_statisticsUpdatePending(false)
+    , m_fetchGeneration(0)
+    , m_adaptiveChunkSize(false)
+    , m_minimumChunkSize(10)
+    , m_maximumChunkSize(500)
+    , m_fetchLatency(0)
+    , m_rowFetchCost(0)
+    , m_snapshotChunkCount(0)
+    , m_incrementalReload(false)
+    , m_reload{false, 0, -1, {}, {}, {}}
+    , m_rowsLoadingType(QIviPagingModel::FetchMore)
+    , m_sharedCacheEnabled(false)
+    , m_sharedCache(nullptr)
+    , m_backgroundDecoding(false)
+    , m_pendingDecodes(0)
+    , m_replayingDecoded(false)
+    , m_decodedChunkCount(0)
+    , m_decodeTime(0)
+    , m_decodeHandOffTime(0)
     , m_identifier(QUuid::createUuid())
     , m_fetchMoreThreshold(10)
     , m_fetchedDataCount(0)
@@ -66,10 +248,23 @@ QIviPagingModelPrivate::QIviPagingModelPrivate(const QString &interface, QIviPag
     qRegisterMetaType<QIviPagingModel::LoadingType>();
     qRegisterMetaType<QIviStandardItem>();
     qRegisterMetaType<QIviStandardItem>("QIviSearchAndBrowseModelItem");
+    qRegisterMetaType<QIviPagingModelStatistics>();
+    m_fetchTimer.start();
+
+    m_snapshotTimer.setSingleShot(true);
+    m_snapshotTimer.setInterval(snapshotDelay);
+    QObject::connect(&m_snapshotTimer, &QTimer::timeout, [this]() {
+        writeSnapshot();
+    });
 }
 
 QIviPagingModelPrivate::~QIviPagingModelPrivate()
 {
+    flushSnapshot();
+    if (m_sharedCache)
+        m_sharedCache->release(this);
+    if (m_decodeRelay)
+        m_decodeRelay->m_model = nullptr;
 }
 
 void QIviPagingModelPrivate::initialize()
@@ -113,61 +308,224 @@ void QIviPagingModelPrivate::onCapabilitiesChanged(const QUuid &identifier, QtIv
     Q_Q(QIviPagingModel);
     m_capabilities = capabilities;
     emit q->capabilitiesChanged(capabilities);
+
+    updateSharedCache();
 }
 
 void QIviPagingModelPrivate::onDataFetched(const QUuid &identifier, const QList<QVariant> &items, int start, bool moreAvailable)
 {
-    if (!identifier.isNull() && (!items.count() || identifier != m_identifier))
+    if (!identifier.isNull() && identifier != m_identifier)
+        return;
+
+    //Convert the items on a worker thread and insert them once they are ready. The following
+    //replies need to wait as well, to keep their order.
+    if ((m_backgroundDecoding && !items.isEmpty()) || (m_pendingDecodes && !m_replayingDecoded)) {
+        decodeInBackground(items, [this, identifier, items, start, moreAvailable](const QVector<DecodedRow> &decoded) {
+            processFetchedData(identifier, items, start, moreAvailable, decoded);
+        });
+        return;
+    }
+
+    processFetchedData(identifier, items, start, moreAvailable, QVector<DecodedRow>());
+}
+
+void QIviPagingModelPrivate::processFetchedData(const QUuid &identifier, const QList<QVariant> &items, int start, bool moreAvailable, const QVector<DecodedRow> &decoded)
+{
+    //The reply belongs to a request which was issued before the model was reset or which was
+    //cancelled. Data which wasn't requested at all is only accepted if it was sent to all instances.
+    qint64 requestTime = -1;
+    if (!takePendingFetch(start, &requestTime) && (!identifier.isNull() || requestTime >= 0))
         return;
 
+    //Outdated replies might still use a previous chunk size
     Q_ASSERT(items.count() <= m_chunkSize);
-    Q_ASSERT((start + items.count() - 1) / m_chunkSize == start / m_chunkSize);
+    Q_ASSERT(items.isEmpty() || (start + items.count() - 1) / m_chunkSize == start / m_chunkSize);
+
+    if (requestTime >= 0) {
+        const qint64 elapsed = m_fetchTimer.nsecsElapsed() - requestTime;
+        recordFetch(start, items.count(), elapsed);
+        addFetchSample(items.count(), elapsed);
+    }
+
+    //Hand the chunk to the other instances which are waiting for the same data
+    if (m_sharedCache && !identifier.isNull())
+        m_sharedCache->chunkFetched(this, start, items, moreAvailable);
+
+    //A derived model might want to insert the rows on its own
+    if (handleFetchedData(items, start, moreAvailable))
+        return;
+
+    //The rows of an incremental reload are applied at once, when all chunks arrived
+    if (m_reload.active) {
+        const int chunkIndex = start / m_reload.chunkSize;
+        if (start % m_reload.chunkSize == 0 && chunkIndex < m_reload.chunks.count() && !m_reload.received.testBit(chunkIndex)) {
+            m_reload.chunks[chunkIndex] = items;
+            m_reload.moreAvailable[chunkIndex] = moreAvailable;
+            m_reload.received.setBit(chunkIndex);
+            checkIncrementalReload();
+        }
+        return;
+    }
+
+    //The backend has no rows for this chunk, e.g. as the data ends exactly at the previous chunk
+    if (items.isEmpty())
+        return;
 
     Q_Q(QIviPagingModel);
-    m_moreAvailable = moreAvailable;
 
     if (m_loadingType == QIviPagingModel::FetchMore) {
-        q->beginInsertRows(QModelIndex(), m_itemList.count(), m_itemList.count() + items.count() -1);
-        m_itemList += items;
-        m_fetchedDataCount = m_itemList.count();
-        q->endInsertRows();
+        if (start < m_itemList.count()) {
+            //A chunk which got evicted from the cache or was restored from a snapshot has been fetched again
+            const int overlap = qMin(items.count(), m_itemList.count() - start);
+            replaceRows(start, items.mid(0, overlap), decoded.mid(0, overlap));
+
+            const int end = start + items.count();
+            if (end > m_itemList.count()) {
+                q->beginInsertRows(QModelIndex(), m_itemList.count(), end - 1);
+                insertRows(m_itemList.count(), items.mid(overlap), decoded.mid(overlap));
+                q->endInsertRows();
+                m_chunkCache.resize((m_itemList.count() + m_chunkSize - 1) / m_chunkSize);
+            } else if (end < m_itemList.count() && !moreAvailable) {
+                //The backend has no data after this reply anymore, the following rows are outdated
+                q->beginRemoveRows(QModelIndex(), end, m_itemList.count() - 1);
+                removeRows(end, m_itemList.count() - end);
+                q->endRemoveRows();
+                m_chunkCache.updateAvailability(end);
+            }
+
+            //The reply reached the end of the fetched rows
+            if (end >= m_itemList.count()) {
+                m_moreAvailable = moreAvailable;
+                m_fetchedDataCount = m_itemList.count();
+            }
+        } else {
+            m_moreAvailable = moreAvailable;
+            q->beginInsertRows(QModelIndex(), m_itemList.count(), m_itemList.count() + items.count() -1);
+            insertRows(m_itemList.count(), items, decoded);
+            m_fetchedDataCount = m_itemList.count();
+            q->endInsertRows();
+
+            m_chunkCache.resize((m_itemList.count() + m_chunkSize - 1) / m_chunkSize);
+        }
+        m_chunkCache.setChunkAvailable(start / m_chunkSize);
     } else {
+        m_moreAvailable = moreAvailable;
         const int newSize = start + items.count();
-        if (m_itemList.count() <  newSize || m_availableChunks.count() < newSize / m_chunkSize) {
+        if (m_itemList.count() <  newSize || m_chunkCache.chunkCount() < newSize / m_chunkSize) {
             qWarning() << "countChanged signal needs to be emitted before the dataFetched signal";
             return;
         }
 
         m_fetchedDataCount = start + items.count();
 
-        for (int i = 0; i < items.count(); i++)
-            m_itemList.replace(start + i, items.at(i));
+        replaceRows(start, items, decoded);
+
+        m_chunkCache.setChunkAvailable(start / m_chunkSize);
+    }
+
+    m_chunkCache.cacheChunk(start / m_chunkSize);
+    if (start / m_chunkSize < m_snapshotChunkCount)
+        scheduleSnapshot();
+    adaptChunkSize();
+}
+
+void QIviPagingModelPrivate::decodeInBackground(const QList<QVariant> &items, const std::function<void(const QVector<DecodedRow> &)> &handler)
+{
+    //The relay needs to be deleted in the thread of the model, even if a task releases it last
+    if (!m_decodeRelay)
+        m_decodeRelay = QSharedPointer<QIviPagingModelDecodeRelay>(new QIviPagingModelDecodeRelay(this), &QObject::deleteLater);
+
+    QThreadPool *pool = decodeThreadPool();
+    if (pool->maxThreadCount() != 1)
+        pool->setMaxThreadCount(1);
 
-        m_availableChunks.setBit(start / m_chunkSize);
+    m_pendingDecodes++;
+    pool->start(new QIviPagingModelDecodeTask(m_decodeRelay, items, handler));
+}
 
-        emit q->dataChanged(q->index(start), q->index(start + items.count() -1));
+QVector<QIviPagingModelPrivate::DecodedRow> QIviPagingModelPrivate::decodeRows(const QList<QVariant> &items)
+{
+    //This runs on a worker thread and can't print warnings, as they might need the QML engine of
+    //the model. Items which can't be converted are handled by setRow() on the thread of the model.
+    QVector<DecodedRow> rows;
+    rows.reserve(items.count());
+    for (const QVariant &item : items) {
+        DecodedRow row = {false, QString(), QString(), QString()};
+        const QMetaType type(item.userType());
+        if (item.isValid() && type.flags().testFlag(QMetaType::IsGadget)) {
+            for (const QMetaObject *mo = type.metaObject(); mo; mo = mo->superClass()) {
+                if (mo != &QIviStandardItem::staticMetaObject)
+                    continue;
+
+                const QIviStandardItem *standardItem = reinterpret_cast<const QIviStandardItem *>(item.constData());
+                row = {true, standardItem->id(), standardItem->name(), standardItem->type()};
+                break;
+            }
+        }
+        rows.append(row);
     }
+    return rows;
 }
 
 void QIviPagingModelPrivate::onCountChanged(const QUuid &identifier, int new_length)
 {
+    //Keep the order of the backend signals while chunks are decoded
+    if (m_pendingDecodes && !m_replayingDecoded) {
+        decodeInBackground(QList<QVariant>(), [this, identifier, new_length](const QVector<DecodedRow> &) {
+            onCountChanged(identifier, new_length);
+        });
+        return;
+    }
+
+    if ((identifier.isNull() || identifier == m_identifier) && handleCountChanged(new_length))
+        return;
+
+    if (m_sharedCache && identifier == m_identifier)
+        m_sharedCache->setCount(new_length);
+
+    if (m_reload.active && (identifier.isNull() || identifier == m_identifier)) {
+        //The chunks behind the new end might never be answered
+        m_reload.count = new_length;
+        checkIncrementalReload();
+        return;
+    }
+
     if (!identifier.isNull() && (identifier != m_identifier || m_loadingType != QIviPagingModel::DataChanged || m_itemList.count() == new_length))
         return;
 
     Q_Q(QIviPagingModel);
-    q->beginInsertRows(QModelIndex(), m_itemList.count(), m_itemList.count() + new_length -1);
-    for (int i = 0; i < new_length; i++)
-        m_itemList.append(QVariant());
-    q->endInsertRows();
+    const int oldLength = m_itemList.count();
+    if (new_length > oldLength) {
+        q->beginInsertRows(QModelIndex(), oldLength, new_length -1);
+        insertEmptyRows(oldLength, new_length - oldLength);
+        q->endInsertRows();
+
+        m_chunkCache.resize(new_length / m_chunkSize + 1);
+    } else if (new_length < oldLength) {
+        //E.g. the rows restored from a snapshot are outdated
+        q->beginRemoveRows(QModelIndex(), new_length, oldLength -1);
+        removeRows(new_length, oldLength - new_length);
+        q->endRemoveRows();
 
-    m_availableChunks.resize(new_length / m_chunkSize + 1);
+        m_chunkCache.updateAvailability(new_length);
+    }
 }
 
 void QIviPagingModelPrivate::onDataChanged(const QUuid &identifier, const QList<QVariant> &data, int start, int count)
 {
+    if (m_pendingDecodes && !m_replayingDecoded) {
+        decodeInBackground(QList<QVariant>(), [this, identifier, data, start, count](const QVector<DecodedRow> &) {
+            onDataChanged(identifier, data, start, count);
+        });
+        return;
+    }
+
     if (!identifier.isNull() && identifier != m_identifier)
         return;
 
+    if (handleDataChanged())
+        return;
+
     if (start < 0 || start > m_itemList.count()) {
         qWarning("provided start argument is out of range");
         return;
@@ -180,33 +538,75 @@ void QIviPagingModelPrivate::onDataChanged(const QUuid &identifier, const QList<
 
     Q_Q(QIviPagingModel);
 
-    //delta > 0 insert rows
-    //delta < 0 remove rows
-    int delta = data.count() - count;
+    //The chunks shared with other instances are outdated now
+    if (m_sharedCache)
+        m_sharedCache->clear();
+
+    //Backends report a moved item by updating the range between the old and the new position
+    if (data.count() == count) {
+        QStringList oldIds;
+        QStringList newIds;
+        for (int i = 0; i < count; i++) {
+            oldIds.append(m_idColumn.at(start + i));
+            const QIviStandardItem *item = qtivi_gadgetFromVariant<QIviStandardItem>(q, data.at(i));
+            newIds.append(item ? item->id() : QString());
+        }
+
+        int from = -1;
+        int to = -1;
+        if (qtivi_findMovedRow(oldIds, newIds, &from, &to)) {
+            q->beginMoveRows(QModelIndex(), start + from, start + from, QModelIndex(), start + (to > from ? to + 1 : to));
+            moveRow(start + from, start + to);
+            q->endMoveRows();
+
+            //The content of the rows might have changed together with their position
+            int firstChanged = -1;
+            int lastChanged = -1;
+            for (int i = 0; i < count; i++) {
+                if (isSameRow(start + i, data.at(i)))
+                    continue;
+                setRow(start + i, data.at(i));
+                if (firstChanged == -1)
+                    firstChanged = i;
+                lastChanged = i;
+            }
+            if (firstChanged != -1)
+                emit q->dataChanged(q->index(start + firstChanged), q->index(start + lastChanged));
+
+            m_chunkCache.updateAvailability(start);
+            return;
+        }
+    }
+
     //find data overlap for updates
-    int updateCount = qMin(data.count(), count);
-    int updateCountEnd = updateCount > 0 ? updateCount + 1 : 0;
+    const int updateCount = qMin(data.count(), count);
     //range which is either added or removed
-    int insertRemoveStart = start + updateCountEnd;
-    int insertRemoveCount = qMax(data.count(), count) - updateCount;
+    const int spliceStart = start + updateCount;
+    const int delta = data.count() - count;
 
     if (updateCount > 0) {
         for (int i = start, j=0; j < updateCount; i++, j++)
-            m_itemList.replace(i, data.at(j));
+            setRow(i, data.at(j));
         emit q->dataChanged(q->index(start), q->index(start + updateCount -1));
     }
 
+    if (delta == 0)
+        return;
+
     if (delta < 0) { //Remove
-        q->beginRemoveRows(QModelIndex(), insertRemoveStart, insertRemoveStart + insertRemoveCount -1);
-        for (int i = insertRemoveStart; i < insertRemoveStart + insertRemoveCount; i++)
-            m_itemList.removeAt(i);
+        q->beginRemoveRows(QModelIndex(), spliceStart, spliceStart - delta -1);
+        removeRows(spliceStart, -delta);
         q->endRemoveRows();
-    } else if (delta > 0) { //Insert
-        q->beginInsertRows(QModelIndex(), insertRemoveStart, insertRemoveStart + insertRemoveCount -1);
-        for (int i = insertRemoveStart, j = updateCountEnd; i < insertRemoveStart + insertRemoveCount; i++, j++)
-            m_itemList.insert(i, data.at(j));
+    } else { //Insert
+        q->beginInsertRows(QModelIndex(), spliceStart, spliceStart + delta -1);
+        insertRows(spliceStart, data.mid(updateCount));
         q->endInsertRows();
     }
+
+    if (m_fetchedDataCount > spliceStart)
+        m_fetchedDataCount = qMax(spliceStart, m_fetchedDataCount + delta);
+
+    m_chunkCache.updateAvailability(spliceStart);
 }
 
 void QIviPagingModelPrivate::onFetchMoreThresholdReached()
@@ -219,15 +619,301 @@ void QIviPagingModelPrivate::resetModel()
 {
     Q_Q(QIviPagingModel);
 
+    //Other instances might wait for the data requested by this instance
+    if (m_sharedCache)
+        m_sharedCache->abandonFetches(this);
+    cancelPendingFetches();
+    updateSharedCache();
+
+    //Keep the rows and only report the differences once the new data arrived. The rows of the
+    //other loading type can't be reused.
+    if (m_incrementalReload && !m_itemList.isEmpty() && m_rowsLoadingType == m_loadingType && backend()) {
+        startIncrementalReload();
+        return;
+    }
+    m_reload.active = false;
+    m_rowsLoadingType = m_loadingType;
+
     q->beginResetModel();
-    m_itemList.clear();
-    m_availableChunks.clear();
-    m_fetchedDataCount = 0;
+    clearModel();
     //Setting this to true to let fetchMore do one first fetchcall.
     m_moreAvailable = true;
+    const int restoredChunks = restoreSnapshot();
     q->endResetModel();
 
-    q->fetchMore(QModelIndex());
+    if (restoredChunks) {
+        //Reconcile the restored rows with the current data of the backend
+        for (int i = 0; i < restoredChunks; i++)
+            fetchData(i * m_chunkSize);
+    } else {
+        q->fetchMore(QModelIndex());
+    }
+}
+
+void QIviPagingModelPrivate::clearModel()
+{
+    //Needs to be called between beginResetModel() and endResetModel()
+    flushSnapshot();
+    clearRows();
+    m_restoredRows.clear();
+    m_chunkCache.clear();
+    m_fetchedDataCount = 0;
+    m_viewportFirst = -1;
+    m_viewportLast = -1;
+    m_lastAccessedRow = -1;
+    m_scrollDirection = 0;
+}
+
+bool QIviPagingModelPrivate::handleFetchedData(const QList<QVariant> &items, int start, bool moreAvailable)
+{
+    Q_UNUSED(items)
+    Q_UNUSED(start)
+    Q_UNUSED(moreAvailable)
+    return false;
+}
+
+bool QIviPagingModelPrivate::handleCountChanged(int count)
+{
+    Q_UNUSED(count)
+    return false;
+}
+
+bool QIviPagingModelPrivate::handleDataChanged()
+{
+    return false;
+}
+
+void QIviPagingModelPrivate::startIncrementalReload(int lastRow)
+{
+    //Fetch all chunks up to the last visible one, the rows behind it are fetched again when needed
+    if (lastRow < 0)
+        lastRow = m_explicitViewport ? m_viewportLast : m_lastAccessedRow;
+    lastRow = qBound(0, lastRow, m_itemList.count() - 1);
+    const int chunkCount = lastRow / m_chunkSize + 1;
+
+    m_reload.active = true;
+    m_reload.chunkSize = m_chunkSize;
+    m_reload.count = -1;
+    m_reload.chunks = QVector<QList<QVariant>>(chunkCount);
+    m_reload.moreAvailable = QVector<bool>(chunkCount, false);
+    m_reload.received = QBitArray(chunkCount);
+
+    //The backend might reply synchronously and even trigger another reload
+    for (int i = 0; i < chunkCount && m_reload.active && m_reload.chunkSize == m_chunkSize; i++)
+        fetchData(i * m_chunkSize);
+}
+
+void QIviPagingModelPrivate::checkIncrementalReload()
+{
+    //The reload is complete once all chunks up to the end of the data arrived. The end is either
+    //the first incomplete chunk or the count reported by the backend. The chunks behind it don't
+    //exist anymore and a backend doesn't need to answer them.
+    int chunkCount = m_reload.chunks.count();
+    for (int i = 0; i < m_reload.chunks.count(); i++) {
+        if (m_reload.count >= 0 && i * m_reload.chunkSize >= m_reload.count) {
+            chunkCount = i;
+            break;
+        }
+        if (!m_reload.received.testBit(i))
+            return;
+        if (m_reload.chunks.at(i).count() < m_reload.chunkSize) {
+            chunkCount = i + 1;
+            break;
+        }
+    }
+
+    for (int i = chunkCount; i < m_reload.chunks.count(); i++) {
+        if (!m_reload.received.testBit(i))
+            cancelPendingFetch(i * m_reload.chunkSize);
+        m_reload.chunks[i].clear();
+    }
+
+    finishIncrementalReload();
+}
+
+void QIviPagingModelPrivate::finishIncrementalReload()
+{
+    Q_Q(QIviPagingModel);
+
+    //Only the rows up to the first incomplete chunk are continuous
+    QList<QVariant> items;
+    bool moreAvailable = false;
+    for (int i = 0; i < m_reload.chunks.count(); i++) {
+        const QList<QVariant> &chunk = m_reload.chunks.at(i);
+        items += chunk;
+        moreAvailable = m_reload.moreAvailable.at(i);
+        if (chunk.count() < m_reload.chunkSize)
+            break;
+    }
+    if (m_reload.count >= 0 && items.count() >= m_reload.count)
+        moreAvailable = false;
+    m_reload.active = false;
+
+    applyReloadedRows(qMin(m_itemList.count(), m_reload.chunks.count() * m_reload.chunkSize), items);
+
+    //The rows behind the reloaded ones are outdated
+    const int end = items.count();
+    if (m_loadingType == QIviPagingModel::FetchMore) {
+        if (m_itemList.count() > end) {
+            q->beginRemoveRows(QModelIndex(), end, m_itemList.count() - 1);
+            removeRows(end, m_itemList.count() - end);
+            q->endRemoveRows();
+        }
+    } else {
+        int count = m_reload.count >= 0 ? m_reload.count : m_itemList.count();
+        if (!moreAvailable)
+            count = end;
+        count = qMax(count, end);
+
+        const int clearEnd = qMin(count, m_itemList.count());
+        if (clearEnd > end) {
+            for (int i = end; i < clearEnd; i++)
+                clearRow(i);
+            emit q->dataChanged(q->index(end), q->index(clearEnd - 1));
+        }
+
+        const int oldCount = m_itemList.count();
+        if (count > oldCount) {
+            q->beginInsertRows(QModelIndex(), oldCount, count - 1);
+            insertEmptyRows(oldCount, count - oldCount);
+            q->endInsertRows();
+        } else if (count < oldCount) {
+            q->beginRemoveRows(QModelIndex(), count, oldCount - 1);
+            removeRows(count, oldCount - count);
+            q->endRemoveRows();
+        }
+    }
+
+    m_fetchedDataCount = end;
+    m_moreAvailable = moreAvailable;
+    m_chunkCache.updateAvailability(0);
+    scheduleSnapshot();
+}
+
+void QIviPagingModelPrivate::applyReloadedRows(int oldCount, const QList<QVariant> &items)
+{
+    Q_Q(QIviPagingModel);
+
+    //Match the reloaded items with the first oldCount rows by their id
+    QHash<QString, QVector<int>> newRows;
+    for (int i = 0; i < items.count(); i++) {
+        const QIviStandardItem *item = qtivi_gadgetFromVariant<QIviStandardItem>(q, items.at(i));
+        if (item && !item->id().isEmpty())
+            newRows[item->id()].append(i);
+    }
+
+    //The new position of every row, -1 for the rows without a matching item
+    QVector<int> targets(oldCount, -1);
+    QHash<QString, int> matchCount;
+    for (int row = 0; row < oldCount; row++) {
+        const QString &id = m_idColumn.at(row);
+        auto it = newRows.constFind(id);
+        if (id.isEmpty() || it == newRows.constEnd())
+            continue;
+
+        int &matched = matchCount[id];
+        if (matched < it->count())
+            targets[row] = it->at(matched++);
+    }
+
+    //1. Remove the rows which don't exist anymore, starting at the end to keep the indexes valid
+    for (int row = oldCount - 1; row >= 0; row--) {
+        if (targets.at(row) >= 0)
+            continue;
+
+        int first = row;
+        while (first > 0 && targets.at(first - 1) < 0)
+            first--;
+
+        q->beginRemoveRows(QModelIndex(), first, row);
+        removeRows(first, row - first + 1);
+        targets.remove(first, row - first + 1);
+        q->endRemoveRows();
+        row = first;
+    }
+
+    //2. Move the rows which changed their order. The rows forming the longest increasing sequence
+    //stay where they are and every other row is moved exactly once.
+    QVector<bool> settled = stableRows(targets);
+    QVector<int> movedTargets;
+    for (int row = 0; row < targets.count(); row++) {
+        if (!settled.at(row))
+            movedTargets.append(targets.at(row));
+    }
+    std::sort(movedTargets.begin(), movedTargets.end());
+
+    for (int target : qAsConst(movedTargets)) {
+        const int from = targets.indexOf(target);
+        //Place the row behind the last settled row which precedes it in the new order
+        int to = 0;
+        for (int row = 0; row < targets.count(); row++) {
+            if (settled.at(row) && targets.at(row) < target)
+                to = row + 1;
+        }
+
+        int newRow = from;
+        if (to != from && to != from + 1) {
+            newRow = to > from ? to - 1 : to;
+            q->beginMoveRows(QModelIndex(), from, from, QModelIndex(), to);
+            moveRow(from, newRow);
+            targets.move(from, newRow);
+            settled.move(from, newRow);
+            q->endMoveRows();
+        }
+        settled[newRow] = true;
+    }
+
+    //3. Insert the new items, the remaining rows are ordered by their new position now
+    for (int row = 0; row < items.count();) {
+        if (row < targets.count() && targets.at(row) == row) {
+            row++;
+            continue;
+        }
+
+        const int next = row < targets.count() ? targets.at(row) : items.count();
+        q->beginInsertRows(QModelIndex(), row, next - 1);
+        insertRows(row, items.mid(row, next - row));
+        for (int i = row; i < next; i++)
+            targets.insert(i, i);
+        q->endInsertRows();
+        row = next;
+    }
+
+    //4. Update the content of the rows which were kept. Only the rows which really changed are
+    //reported, as the reload is meant to keep the unchanged rows untouched.
+    replaceRows(0, items, QVector<DecodedRow>(), true);
+    m_restoredRows.clear();
+}
+
+QVector<bool> QIviPagingModelPrivate::stableRows(const QVector<int> &targets)
+{
+    //Longest increasing subsequence of the targets, using patience sorting
+    const int count = targets.count();
+    QVector<int> tails;
+    QVector<int> previous(count, -1);
+    for (int i = 0; i < count; i++) {
+        int low = 0;
+        int high = tails.count();
+        while (low < high) {
+            const int mid = (low + high) / 2;
+            if (targets.at(tails.at(mid)) < targets.at(i))
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        if (low > 0)
+            previous[i] = tails.at(low - 1);
+        if (low == tails.count())
+            tails.append(i);
+        else
+            tails[low] = i;
+    }
+
+    QVector<bool> stable(count, false);
+    for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = previous.at(i))
+        stable[i] = true;
+    return stable;
 }
 
 void QIviPagingModelPrivate::fetchData(int startIndex)
@@ -235,319 +921,1690 @@ void QIviPagingModelPrivate::fetchData(int startIndex)
     if (!backend())
         return;
 
-    m_moreAvailable = false;
     const int start = startIndex >= 0 ? startIndex : m_fetchedDataCount;
+    //The chunk is already on its way, there is no need to request it twice
+    if (isFetchPending(start))
+        return;
+
+    //Fetching a chunk which got evicted from the cache doesn't change whether more data is available
+    if (m_loadingType == QIviPagingModel::DataChanged || start >= m_itemList.count())
+        m_moreAvailable = false;
     const int chunkIndex = start / m_chunkSize;
-    if (chunkIndex < m_availableChunks.size())
-        m_availableChunks.setBit(chunkIndex);
-    backend()->fetchData(m_identifier, start, m_chunkSize);
+    m_chunkCache.setChunkAvailable(chunkIndex);
+    //Only fetch until the end of the chunk. The start isn't aligned to the chunks after the chunk size changed.
+    const int count = m_chunkSize - start % m_chunkSize;
+    //Register the request before calling the backend, as it might reply synchronously
+    m_pendingFetches.append({start, count, m_fetchGeneration, m_fetchTimer.nsecsElapsed()});
+    qCDebug(qLcIviPagingModel) << "Fetching" << count << "rows starting at" << start;
+    scheduleStatisticsUpdate();
+
+    //The chunk might already be available or on its way for another instance with the same query
+    if (m_sharedCache && m_sharedCache->fetch(this, start, count))
+        return;
+
+    backend()->fetchData(m_identifier, start, count);
 }
 
-void QIviPagingModelPrivate::clearToDefaults()
+bool QIviPagingModelPrivate::isFetchPending(int start) const
+{
+    for (const PendingFetch &fetch : m_pendingFetches) {
+        if (fetch.start == start && fetch.generation == m_fetchGeneration)
+            return true;
+    }
+    return false;
+}
+
+int QIviPagingModelPrivate::pendingFetchCount() const
+{
+    //The outdated requests are only kept to discard their replies
+    int count = 0;
+    for (const PendingFetch &fetch : m_pendingFetches) {
+        if (fetch.generation == m_fetchGeneration)
+            count++;
+    }
+    return count;
+}
+
+bool QIviPagingModelPrivate::takePendingFetch(int start, qint64 *requestTime)
+{
+    //Backends are expected to answer the requests for the same start index in order, which means
+    //the oldest pending request for this index is the one which got answered.
+    for (int i = 0; i < m_pendingFetches.count(); i++) {
+        const PendingFetch fetch = m_pendingFetches.at(i);
+        if (fetch.start != start)
+            continue;
+
+        m_pendingFetches.remove(i);
+        if (requestTime)
+            *requestTime = fetch.requestTime;
+        return fetch.generation == m_fetchGeneration;
+    }
+
+    //Data which wasn't requested by this instance, e.g. sent to all instances or the reply to a
+    //request which was cancelled
+    return false;
+}
+
+void QIviPagingModelPrivate::cancelPendingFetches()
+{
+    m_fetchGeneration++;
+
+    if (!backend())
+        return;
+
+    //Requests which are aborted by the backend won't be answered and don't need to be tracked anymore.
+    //All others stay in the list to be able to discard their results once they arrive.
+    for (int i = m_pendingFetches.count() - 1; i >= 0; i--) {
+        const PendingFetch &fetch = m_pendingFetches.at(i);
+        if (fetch.generation != m_fetchGeneration && backend()->cancelFetch(m_identifier, fetch.start, fetch.count))
+            m_pendingFetches.remove(i);
+    }
+}
+
+void QIviPagingModelPrivate::cancelPendingFetch(int start)
+{
+    for (int i = 0; i < m_pendingFetches.count(); i++) {
+        PendingFetch &fetch = m_pendingFetches[i];
+        if (fetch.start != start || fetch.generation != m_fetchGeneration)
+            continue;
+
+        //A reply which arrives anyway is discarded, like the replies of a reset model
+        if (backend() && backend()->cancelFetch(m_identifier, fetch.start, fetch.count))
+            m_pendingFetches.remove(i);
+        else
+            fetch.generation = m_fetchGeneration - 1;
+        return;
+    }
+}
+
+void QIviPagingModelPrivate::addFetchSample(int rows, qint64 elapsed)
 {
     Q_Q(QIviPagingModel);
 
-    m_chunkSize = 30;
-    emit q->chunkSizeChanged(m_chunkSize);
-    m_moreAvailable = false;
-    m_identifier = QUuid::createUuid();
-    m_fetchMoreThreshold = 10;
-    emit q->fetchMoreThresholdChanged(m_fetchMoreThreshold);
-    m_fetchedDataCount = 0;
-    m_loadingType = QIviPagingModel::FetchMore;
-    emit q->loadingTypeChanged(m_loadingType);
-    m_capabilities = QtIviCoreModule::NoExtras;
-    emit q->capabilitiesChanged(m_capabilities);
-    m_itemList.clear();
+    m_fetchSamples.append({rows, qreal(elapsed) / 1000000});
+    if (m_fetchSamples.count() > fetchSampleCount)
+        m_fetchSamples.removeFirst();
 
-    resetModel();
+    qreal latency = 0;
+    qreal rowCost = 0;
+    if (!fitFetchSamples(&latency, &rowCost))
+        return;
+
+    if (!qFuzzyCompare(m_fetchLatency, latency)) {
+        m_fetchLatency = latency;
+        emit q->fetchLatencyChanged(latency);
+    }
+    if (!qFuzzyCompare(m_rowFetchCost, rowCost)) {
+        m_rowFetchCost = rowCost;
+        emit q->rowFetchCostChanged(rowCost);
+    }
 }
 
-const QIviStandardItem *QIviPagingModelPrivate::itemAt(int i) const
+void QIviPagingModelPrivate::recordFetch(int start, int rows, qint64 elapsed)
 {
-    const QVariant &var = m_itemList.at(i);
-    if (!var.isValid())
-        return nullptr;
+    const qreal msecs = qreal(elapsed) / 1000000;
+    m_fetchCount++;
+    m_totalFetchLatency += msecs;
+    m_fetchLatencyHistogram[QIviPagingModelStatisticsPrivate::latencyBucket(msecs)]++;
 
-    return qtivi_gadgetFromVariant<QIviStandardItem>(q_ptr, var);
+    qCDebug(qLcIviPagingModel) << "Fetched" << rows << "rows starting at" << start << "in" << msecs << "ms";
+    scheduleStatisticsUpdate();
 }
 
-QIviPagingModelInterface *QIviPagingModelPrivate::backend() const
+void QIviPagingModelPrivate::recordCacheAccess(int row, int role, bool hit) const
 {
-    return QIviAbstractFeatureListModelPrivate::backend<QIviPagingModelInterface*>();
+    if (!hit)
+        qCDebug(qLcIviPagingModel) << "Cache miss for row" << row << "and role" << role;
+
+    //This is called for every call of data(), only count the accesses if requested
+    if (!m_statisticsEnabled)
+        return;
+
+    if (hit) {
+        m_cacheHits++;
+        m_roleCacheHits[role]++;
+    } else {
+        m_cacheMisses++;
+        m_roleCacheMisses[role]++;
+    }
+    scheduleStatisticsUpdate();
 }
 
-/*!
-    \class QIviPagingModel
-    \inmodule QtIviCore
-    \brief The QIviPagingModel is a generic model to load its data using the "Paging" aproach.
+void QIviPagingModelPrivate::scheduleStatisticsUpdate() const
+{
+    //The counters change with every call of data(), notify about them at most once per event loop iteration
+    if (!m_statisticsEnabled || m_statisticsUpdatePending)
+        return;
 
-    The QIviPagingModel should be used directly or as a base class whenever a lot of data needs to be
-    presented in a ListView.
+    m_statisticsUpdatePending = true;
+    QIviPagingModel *q = const_cast<QIviPagingModel *>(q_func());
+    QMetaObject::invokeMethod(q, [this, q]() {
+        m_statisticsUpdatePending = false;
+        emit q->statisticsChanged();
+    }, Qt::QueuedConnection);
+}
 
-    The model only fetches the data it really needs and can it can be configured how this can be done using
-    the loadingType property.
+QIviPagingModelStatistics QIviPagingModelPrivate::statistics() const
+{
+    Q_Q(const QIviPagingModel);
+
+    const QHash<int, QByteArray> roleNames = q->roleNames();
+    const auto roleName = [&roleNames](int role) {
+        const QByteArray name = roleNames.value(role);
+        return name.isEmpty() ? QString::number(role) : QString::fromLatin1(name);
+    };
+
+    QIviPagingModelStatistics statistics;
+    QIviPagingModelStatisticsPrivate *data = statistics.d.data();
+    data->m_cacheHits = m_cacheHits;
+    data->m_cacheMisses = m_cacheMisses;
+    for (auto it = m_roleCacheHits.cbegin(); it != m_roleCacheHits.cend(); ++it)
+        data->m_roleCacheHits.insert(roleName(it.key()), it.value());
+    for (auto it = m_roleCacheMisses.cbegin(); it != m_roleCacheMisses.cend(); ++it)
+        data->m_roleCacheMisses.insert(roleName(it.key()), it.value());
+    data->m_pendingFetches = pendingFetchCount();
+    data->m_fetchCount = m_fetchCount;
+    data->m_averageFetchLatency = m_fetchCount ? m_totalFetchLatency / m_fetchCount : 0;
+    data->m_fetchLatencyHistogram = m_fetchLatencyHistogram;
+    data->m_rowCount = m_itemList.count();
+    for (const QVariant &item : m_itemList) {
+        if (item.isValid())
+            data->m_cachedRowCount++;
+    }
+    data->m_cachedChunkCount = m_chunkCache.cachedChunkCount();
+    data->m_evictedChunkCount = m_evictedChunkCount;
+    data->m_decodedChunkCount = m_decodedChunkCount;
+    data->m_decodeTime = qreal(m_decodeTime) / 1000000;
+    data->m_decodeHandOffTime = qreal(m_decodeHandOffTime) / 1000000;
+    return statistics;
+}
+
+bool QIviPagingModelPrivate::fitFetchSamples(qreal *latency, qreal *rowCost) const
+{
+    //Least squares fit of time = latency + rowCost * rows over the recent fetches
+    const int count = m_fetchSamples.count();
+    if (count < 2)
+        return false;
+
+    qreal sumRows = 0;
+    qreal sumMsecs = 0;
+    for (const FetchSample &sample : m_fetchSamples) {
+        sumRows += sample.rows;
+        sumMsecs += sample.msecs;
+    }
+    const qreal meanRows = sumRows / count;
+    const qreal meanMsecs = sumMsecs / count;
+
+    qreal covariance = 0;
+    qreal variance = 0;
+    for (const FetchSample &sample : m_fetchSamples) {
+        covariance += (sample.rows - meanRows) * (sample.msecs - meanMsecs);
+        variance += (sample.rows - meanRows) * (sample.rows - meanRows);
+    }
+
+    //All fetches returned the same number of rows, the time can't be split
+    if (qFuzzyIsNull(variance))
+        return false;
+
+    *rowCost = qMax(qreal(0), covariance / variance);
+    *latency = qMax(qreal(0), meanMsecs - *rowCost * meanRows);
+    return true;
+}
+
+void QIviPagingModelPrivate::adaptChunkSize()
+{
+    //Wait for the outstanding requests, as they still use the old chunk size
+    if (!m_adaptiveChunkSize || m_fetchSamples.count() < 4 || pendingFetchCount())
+        return;
+
+    Q_Q(QIviPagingModel);
+
+    int chunkSize = m_chunkSize;
+    qreal latency = 0;
+    qreal rowCost = 0;
+    if (fitFetchSamples(&latency, &rowCost) && rowCost > 0) {
+        //Fetch enough rows to make the fixed latency at most half of the time needed for a chunk,
+        //but stay within the latency budget
+        qreal rows = latency / rowCost;
+        if (latency < fetchLatencyBudget)
+            rows = qMin(rows, (fetchLatencyBudget - latency) / rowCost);
+        chunkSize = qRound(rows);
+    } else {
+        //Without a usable estimate, scale the chunk towards the latency budget. This also varies the
+        //number of fetched rows, which is needed to estimate the latency and the cost per row.
+        qreal sumRows = 0;
+        qreal sumMsecs = 0;
+        for (const FetchSample &sample : qAsConst(m_fetchSamples)) {
+            sumRows += sample.rows;
+            sumMsecs += sample.msecs;
+        }
+        const qreal factor = qFuzzyIsNull(sumMsecs) ? 2 : qBound(qreal(0.5), fetchLatencyBudget / sumMsecs * m_fetchSamples.count(), qreal(2));
+        chunkSize = qRound(sumRows / m_fetchSamples.count() * factor);
+    }
+    chunkSize = qBound(m_minimumChunkSize, chunkSize, qMax(m_minimumChunkSize, m_maximumChunkSize));
+
+    //Ignore small changes to not refetch data all the time
+    if (qAbs(chunkSize - m_chunkSize) * 4 <= m_chunkSize)
+        return;
+
+    q->setChunkSize(chunkSize);
+}
+
+void QIviPagingModelPrivate::evictChunk(int chunkIndex, int start, int end)
+{
+    for (int i = start; i < end; i++)
+        clearRow(i);
+    m_evictedChunkCount++;
+
+    qCDebug(qLcIviPagingModel) << "Evicted chunk" << chunkIndex << "with the rows" << start << "to" << end - 1;
+    scheduleStatisticsUpdate();
+}
+
+void QIviPagingModelPrivate::onRowAccessed(int row)
+{
+    //An explicitly set viewport takes precedence over the one inferred from the data() calls
+    if (m_explicitViewport)
+        return;
+
+    onVisibleRowsChanged(row, row);
+    if (m_prefetchDistance <= 0)
+        return;
+
+    const int chunkIndex = row / m_chunkSize;
+    const int previousRow = m_lastAccessedRow;
+    m_lastAccessedRow = row;
+
+    if (previousRow < 0) {
+        prefetchChunks(chunkIndex, chunkIndex, 1, false);
+        return;
+    }
+
+    if (row != previousRow)
+        m_scrollDirection = row > previousRow ? 1 : -1;
+
+    //Only prefetch once a new chunk is entered, not for every accessed row
+    const int chunkDelta = qAbs(chunkIndex - previousRow / m_chunkSize);
+    if (chunkDelta == 0)
+        return;
+
+    prefetchChunks(chunkIndex, chunkIndex, m_scrollDirection, chunkDelta > 1);
+}
+
+void QIviPagingModelPrivate::onVisibleRowsChanged(int first, int last)
+{
+    Q_UNUSED(first)
+    Q_UNUSED(last)
+}
+
+void QIviPagingModelPrivate::prefetchChunks(int firstChunk, int lastChunk, int direction, bool fastScrolling)
+{
+    if (m_prefetchDistance <= 0)
+        return;
+
+    //Look further ahead if the view skipped whole chunks, e.g. during a flick
+    int distance = fastScrolling ? m_prefetchDistance * 2 : m_prefetchDistance;
+    int behind = 1;
+
+    //The prefetched chunks should never evict the visible ones from the cache
+    const int cacheLimit = m_chunkCache.cacheLimit();
+    if (cacheLimit > 0) {
+        const int available = cacheLimit - (lastChunk - firstChunk + 1);
+        distance = qBound(0, distance, available);
+        behind = qBound(0, available - distance, 1);
+    }
+
+    if (direction >= 0) {
+        for (int i = 1; i <= distance; i++)
+            prefetchChunk(lastChunk + i);
+        if (behind)
+            prefetchChunk(firstChunk - 1);
+    } else {
+        for (int i = 1; i <= distance; i++)
+            prefetchChunk(firstChunk - i);
+        if (behind)
+            prefetchChunk(lastChunk + 1);
+    }
+}
+
+void QIviPagingModelPrivate::prefetchChunk(int chunkIndex)
+{
+    if (chunkIndex < 0 || !backend())
+        return;
+
+    const int start = chunkIndex * m_chunkSize;
+    if (start < m_itemList.count()) {
+        if (m_chunkCache.isChunkMissing(chunkIndex))
+            fetchData(start);
+    } else if (m_loadingType == QIviPagingModel::FetchMore && start == m_itemList.count() && m_moreAvailable) {
+        //In FetchMore mode only the chunk following the already fetched data can be requested
+        fetchData(-1);
+    }
+}
+
+void QIviPagingModelPrivate::clearToDefaults()
+{
+    Q_Q(QIviPagingModel);
+
+    m_chunkSize = 30;
+    emit q->chunkSizeChanged(m_chunkSize);
+    m_moreAvailable = false;
+    m_identifier = QUuid::createUuid();
+    m_pendingFetches.clear();
+    m_fetchMoreThreshold = 10;
+    emit q->fetchMoreThresholdChanged(m_fetchMoreThreshold);
+    m_chunkCache.setCacheLimit(0);
+    emit q->cacheLimitChanged(0);
+    m_prefetchDistance = 0;
+    emit q->prefetchDistanceChanged(m_prefetchDistance);
+    m_explicitViewport = false;
+    m_cacheHits = 0;
+    m_cacheMisses = 0;
+    m_roleCacheHits.clear();
+    m_roleCacheMisses.clear();
+    m_fetchCount = 0;
+    m_totalFetchLatency = 0;
+    m_fetchLatencyHistogram.fill(0);
+    m_evictedChunkCount = 0;
+    m_decodedChunkCount = 0;
+    m_decodeTime = 0;
+    m_decodeHandOffTime = 0;
+    emit q->statisticsChanged();
+    m_statisticsEnabled = false;
+    emit q->statisticsEnabledChanged(m_statisticsEnabled);
+    m_adaptiveChunkSize = false;
+    emit q->adaptiveChunkSizeChanged(m_adaptiveChunkSize);
+    m_minimumChunkSize = 10;
+    emit q->minimumChunkSizeChanged(m_minimumChunkSize);
+    m_maximumChunkSize = 500;
+    emit q->maximumChunkSizeChanged(m_maximumChunkSize);
+    m_fetchSamples.clear();
+    m_fetchLatency = 0;
+    emit q->fetchLatencyChanged(m_fetchLatency);
+    m_rowFetchCost = 0;
+    emit q->rowFetchCostChanged(m_rowFetchCost);
+    m_snapshotChunkCount = 0;
+    emit q->snapshotChunkCountChanged(m_snapshotChunkCount);
+    m_incrementalReload = false;
+    emit q->incrementalReloadChanged(m_incrementalReload);
+    m_reload.active = false;
+    m_backgroundDecoding = false;
+    emit q->backgroundDecodingChanged(m_backgroundDecoding);
+    m_sharedCacheEnabled = false;
+    emit q->sharedCacheChanged(m_sharedCacheEnabled);
+    m_fetchedDataCount = 0;
+    m_loadingType = QIviPagingModel::FetchMore;
+    emit q->loadingTypeChanged(m_loadingType);
+    m_capabilities = QtIviCoreModule::NoExtras;
+    emit q->capabilitiesChanged(m_capabilities);
+    clearRows();
+
+    resetModel();
+}
+
+const QIviStandardItem *QIviPagingModelPrivate::itemAt(int i) const
+{
+    const QVariant &var = m_itemList.at(i);
+    if (!var.isValid())
+        return nullptr;
+
+    return qtivi_gadgetFromVariant<QIviStandardItem>(q_ptr, var);
+}
+
+void QIviPagingModelPrivate::setRow(int row, const QVariant &item)
+{
+    //Extract the columns needed by data() once, instead of converting the gadget on every call.
+    //Items which are not derived from QIviStandardItem are stored as empty rows.
+    const QIviStandardItem *standardItem = item.isValid() ? qtivi_gadgetFromVariant<QIviStandardItem>(q_ptr, item) : nullptr;
+    if (!standardItem) {
+        clearRow(row);
+        return;
+    }
+
+    m_itemList[row] = item;
+    m_idColumn[row] = standardItem->id();
+    m_nameColumn[row] = standardItem->name();
+    m_typeColumn[row] = standardItem->type();
+}
+
+void QIviPagingModelPrivate::setDecodedRow(int row, const QVariant &item, const DecodedRow &decoded)
+{
+    if (!decoded.valid) {
+        setRow(row, item);
+        return;
+    }
+
+    m_itemList[row] = item;
+    m_idColumn[row] = decoded.id;
+    m_nameColumn[row] = decoded.name;
+    m_typeColumn[row] = decoded.type;
+}
+
+void QIviPagingModelPrivate::clearRow(int row)
+{
+    m_itemList[row] = QVariant();
+    m_idColumn[row] = QString();
+    m_nameColumn[row] = QString();
+    m_typeColumn[row] = QString();
+}
+
+void QIviPagingModelPrivate::insertRows(int row, const QList<QVariant> &items, const QVector<DecodedRow> &decoded)
+{
+    insertEmptyRows(row, items.count());
+    for (int i = 0; i < items.count(); i++) {
+        if (decoded.isEmpty())
+            setRow(row + i, items.at(i));
+        else
+            setDecodedRow(row + i, items.at(i), decoded.at(i));
+    }
+}
+
+void QIviPagingModelPrivate::insertEmptyRows(int row, int count)
+{
+    m_itemList.insert(row, count, QVariant());
+    m_idColumn.insert(row, count, QString());
+    m_nameColumn.insert(row, count, QString());
+    m_typeColumn.insert(row, count, QString());
+}
+
+void QIviPagingModelPrivate::removeRows(int row, int count)
+{
+    m_itemList.remove(row, count);
+    m_idColumn.remove(row, count);
+    m_nameColumn.remove(row, count);
+    m_typeColumn.remove(row, count);
+}
+
+void QIviPagingModelPrivate::moveRow(int from, int to)
+{
+    m_itemList.move(from, to);
+    m_idColumn.move(from, to);
+    m_nameColumn.move(from, to);
+    m_typeColumn.move(from, to);
+}
+
+void QIviPagingModelPrivate::replaceRows(int start, const QList<QVariant> &items, const QVector<DecodedRow> &decoded, bool reconcile)
+{
+    Q_Q(QIviPagingModel);
+
+    //Only the rows which are reconciled, e.g. the rows restored from a snapshot, are compared with
+    //the new data. All other rows are reported as changed.
+    int changedStart = -1;
+    for (int i = 0; i < items.count(); i++) {
+        const int row = start + i;
+        const bool restored = row < m_restoredRows.size() && m_restoredRows.testBit(row);
+        const bool changed = !(reconcile || restored) || !isSameRow(row, items.at(i));
+        if (restored)
+            m_restoredRows.clearBit(row);
+        if (decoded.isEmpty())
+            setRow(row, items.at(i));
+        else
+            setDecodedRow(row, items.at(i), decoded.at(i));
+
+        if (changed && changedStart < 0) {
+            changedStart = row;
+        } else if (!changed && changedStart >= 0) {
+            emit q->dataChanged(q->index(changedStart), q->index(row - 1));
+            changedStart = -1;
+        }
+    }
+
+    if (changedStart >= 0)
+        emit q->dataChanged(q->index(changedStart), q->index(start + items.count() - 1));
+}
+
+bool QIviPagingModelPrivate::isSameRow(int row, const QVariant &item) const
+{
+    const QVariant &oldItem = m_itemList.at(row);
+    if (!oldItem.isValid() || !item.isValid() || oldItem.userType() != item.userType())
+        return false;
+
+    //Gadgets are usually not comparable, the id identifies the content of an item instead
+    const QIviStandardItem *newItem = qtivi_gadgetFromVariant<QIviStandardItem>(q_ptr, item);
+    if (!newItem)
+        return false;
+
+    return m_idColumn.at(row) == newItem->id()
+            && m_nameColumn.at(row) == newItem->name()
+            && m_typeColumn.at(row) == newItem->type()
+            && itemAt(row)->data() == newItem->data();
+}
+
+QString QIviPagingModelPrivate::cacheKey() const
+{
+    QIviPagingModelInterface *backend = this->backend();
+    if (!backend)
+        return QString();
+
+    return m_feature->interfaceName() + QLatin1Char('/') + QLatin1String(backend->metaObject()->className());
+}
+
+QString QIviPagingModelPrivate::snapshotFilePath(const QString &key)
+{
+    if (key.isEmpty())
+        return QString();
+
+    const QString fileName = QString::fromLatin1(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/qtivi/pagingmodel/") + fileName;
+}
+
+void QIviPagingModelPrivate::scheduleSnapshot()
+{
+    if (m_snapshotChunkCount <= 0)
+        return;
+
+    //Collect the changes of several fetches and write the snapshot only once
+    m_snapshotKey = cacheKey();
+    if (!m_snapshotTimer.isActive())
+        m_snapshotTimer.start();
+}
+
+void QIviPagingModelPrivate::flushSnapshot()
+{
+    if (!m_snapshotTimer.isActive())
+        return;
+
+    m_snapshotTimer.stop();
+    writeSnapshot();
+}
+
+void QIviPagingModelPrivate::writeSnapshot()
+{
+    const QString filePath = snapshotFilePath(m_snapshotKey);
+    if (m_snapshotChunkCount <= 0 || filePath.isEmpty())
+        return;
+
+    //Only a continuous range of rows starting at the beginning is useful for a restore
+    const int maxRows = qMin(m_itemList.count(), m_snapshotChunkCount * m_chunkSize);
+    int rowCount = 0;
+    while (rowCount < maxRows && m_itemList.at(rowCount).isValid())
+        rowCount++;
+
+    if (!rowCount)
+        return;
+
+    //Only the rows are copied here, the serialization and the write happen on a worker thread
+    QThreadPool *pool = snapshotThreadPool();
+    if (pool->maxThreadCount() != 1)
+        pool->setMaxThreadCount(1);
+
+    pool->start(new QIviPagingModelSnapshotTask(filePath, m_snapshotKey, int(m_loadingType), m_itemList.count(),
+                                                m_moreAvailable, m_itemList.mid(0, rowCount)));
+}
+
+int QIviPagingModelPrivate::restoreSnapshot()
+{
+    const QString filePath = snapshotFilePath(cacheKey());
+    if (m_snapshotChunkCount <= 0 || filePath.isEmpty())
+        return 0;
+
+    //A snapshot which is still written, e.g. by a model which was just deleted, is restored completely
+    snapshotThreadPool()->waitForDone();
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return 0;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_12);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString key;
+    int loadingType = -1;
+    int totalCount = 0;
+    bool moreAvailable = false;
+    int rowCount = 0;
+    stream >> magic >> version >> key >> loadingType >> totalCount >> moreAvailable >> rowCount;
+    if (stream.status() != QDataStream::Ok || magic != snapshotMagic || version != snapshotVersion
+            || key != cacheKey() || loadingType != m_loadingType || rowCount <= 0 || totalCount < rowCount) {
+        return 0;
+    }
+
+    QList<QVariant> items;
+    for (int i = 0; i < rowCount; i++) {
+        QByteArray typeName;
+        stream >> typeName;
+        const int type = QMetaType::type(typeName.constData());
+        if (type == QMetaType::UnknownType)
+            return 0;
+
+        QVariant item(type, nullptr);
+        if (!QMetaType::load(stream, type, item.data()) || stream.status() != QDataStream::Ok)
+            return 0;
+        items.append(item);
+    }
+
+    //Only restore whole chunks, to be able to refresh all of them from the backend
+    const int restoredChunks = qMin((rowCount + m_chunkSize - 1) / m_chunkSize, m_snapshotChunkCount);
+    items = items.mid(0, qMin(rowCount, restoredChunks * m_chunkSize));
+
+    if (m_loadingType == QIviPagingModel::DataChanged) {
+        insertEmptyRows(0, totalCount);
+        for (int i = 0; i < items.count(); i++)
+            setRow(i, items.at(i));
+        m_chunkCache.resize(totalCount / m_chunkSize + 1);
+    } else {
+        insertRows(0, items);
+        m_chunkCache.resize((items.count() + m_chunkSize - 1) / m_chunkSize);
+    }
+    m_fetchedDataCount = items.count();
+    m_restoredRows = QBitArray(items.count(), true);
+    //Further data is fetched once the restored chunks got reconciled
+    m_moreAvailable = false;
+
+    return restoredChunks;
+}
+
+void QIviPagingModelPrivate::clearRows()
+{
+    m_itemList.clear();
+    m_idColumn.clear();
+    m_nameColumn.clear();
+    m_typeColumn.clear();
+}
+
+QString QIviPagingModelPrivate::sharedCacheKey() const
+{
+    //Backends which keep a state per instance can't answer the requests of other instances
+    if (!m_capabilities.testFlag(QtIviCoreModule::SupportsSharedResults))
+        return QString();
+
+    const QString key = cacheKey();
+    if (key.isEmpty())
+        return QString();
+
+    //The chunks can only be shared if they are fetched from the same backend and cover the same rows
+    return key + QLatin1Char('/') + QString::number(quintptr(backend()), 16) + QLatin1Char('/')
+            + QString::number(m_loadingType) + QLatin1Char('/') + QString::number(m_chunkSize);
+}
+
+void QIviPagingModelPrivate::updateSharedCache()
+{
+    const QString key = m_sharedCacheEnabled ? sharedCacheKey() : QString();
+    if (m_sharedCache && m_sharedCache->key() == key)
+        return;
+
+    if (m_sharedCache)
+        m_sharedCache->release(this);
+    m_sharedCache = key.isEmpty() ? nullptr : QIviPagingModelSharedCache::acquire(key, this);
+}
+
+void QIviPagingModelPrivate::deliverSharedChunk(int start, const QIviPagingModelSharedCache::Chunk &chunk)
+{
+    //In the DataChanged mode the rows need to exist before the data can be set
+    if (m_sharedCache->count() >= 0)
+        onCountChanged(m_identifier, m_sharedCache->count());
+    onDataFetched(m_identifier, chunk.items, start, chunk.moreAvailable);
+}
+
+QIviPagingModelInterface *QIviPagingModelPrivate::backend() const
+{
+    return QIviAbstractFeatureListModelPrivate::backend<QIviPagingModelInterface*>();
+}
+
+QIviPagingModelSharedCache::QIviPagingModelSharedCache(const QString &key)
+    : m_key(key)
+    , m_count(-1)
+{
+}
+
+QIviPagingModelSharedCache *QIviPagingModelSharedCache::acquire(const QString &key, QIviPagingModelPrivate *member)
+{
+    QIviPagingModelSharedCache *cache = sharedCaches()->value(key);
+    if (!cache) {
+        cache = new QIviPagingModelSharedCache(key);
+        sharedCaches()->insert(key, cache);
+    }
+
+    cache->m_members.append(member);
+    return cache;
+}
+
+void QIviPagingModelSharedCache::release(QIviPagingModelPrivate *member)
+{
+    abandonFetches(member);
+    m_members.removeOne(member);
+
+    //The last instance using this query is gone
+    if (m_members.isEmpty()) {
+        sharedCaches()->remove(m_key);
+        delete this;
+    }
+}
+
+QString QIviPagingModelSharedCache::key() const
+{
+    return m_key;
+}
+
+QVector<QIviPagingModelPrivate *> QIviPagingModelSharedCache::members() const
+{
+    return m_members;
+}
+
+int QIviPagingModelSharedCache::count() const
+{
+    return m_count;
+}
+
+void QIviPagingModelSharedCache::setCount(int count)
+{
+    m_count = count;
+}
+
+QVariantList QIviPagingModelSharedCache::sections() const
+{
+    return m_sections;
+}
+
+void QIviPagingModelSharedCache::setSections(const QVariantList &sections)
+{
+    m_sections = sections;
+}
+
+void QIviPagingModelSharedCache::setCanGoForward(int start, const QVector<bool> &canGoForward)
+{
+    auto it = m_chunks.find(start);
+    if (it != m_chunks.end())
+        it->canGoForward = canGoForward;
+}
+
+bool QIviPagingModelSharedCache::fetch(QIviPagingModelPrivate *member, int start, int count)
+{
+    auto chunkIt = m_chunks.constFind(start);
+    if (chunkIt != m_chunks.constEnd()) {
+        //Deliver a copy, the chunk might be removed while the member processes it
+        const Chunk chunk = chunkIt.value();
+        member->deliverSharedChunk(start, chunk);
+        return true;
+    }
+
+    auto fetchIt = m_fetches.find(start);
+    if (fetchIt != m_fetches.end()) {
+        fetchIt->waiters.append(member);
+        return true;
+    }
+
+    //The member needs to request the chunk from the backend itself
+    m_fetches.insert(start, {member, count, {}});
+    return false;
+}
+
+void QIviPagingModelSharedCache::chunkFetched(QIviPagingModelPrivate *member, int start, const QList<QVariant> &items, bool moreAvailable)
+{
+    auto fetchIt = m_fetches.find(start);
+    if (fetchIt == m_fetches.end() || fetchIt->owner != member)
+        return;
+
+    const QVector<QIviPagingModelPrivate *> waiters = fetchIt->waiters;
+    m_fetches.erase(fetchIt);
+
+    //The items are implicitly shared with the models, keeping them here is cheap
+    if (!m_chunks.contains(start))
+        m_chunkOrder.append(start);
+    m_chunks.insert(start, {items, moreAvailable, {}});
+    evictChunks();
+
+    const Chunk chunk = {items, moreAvailable, {}};
+    for (QIviPagingModelPrivate *waiter : waiters)
+        waiter->deliverSharedChunk(start, chunk);
+}
+
+void QIviPagingModelSharedCache::abandonFetches(QIviPagingModelPrivate *member)
+{
+    for (auto it = m_fetches.begin(); it != m_fetches.end();) {
+        const int start = it.key();
+        //The member doesn't expect the data anymore
+        if (it->waiters.removeAll(member))
+            member->takePendingFetch(start);
+
+        if (it->owner != member) {
+            ++it;
+            continue;
+        }
+
+        if (it->waiters.isEmpty()) {
+            it = m_fetches.erase(it);
+            continue;
+        }
+
+        //Another member needs to request the data instead, as the reply will be dropped
+        QIviPagingModelPrivate *newOwner = it->waiters.takeFirst();
+        it->owner = newOwner;
+        const int count = it->count;
+        newOwner->backend()->fetchData(newOwner->m_identifier, start, count);
+        //The backend might have replied synchronously and modified the hash
+        it = m_fetches.begin();
+    }
+}
+
+void QIviPagingModelSharedCache::clear()
+{
+    m_chunks.clear();
+    m_chunkOrder.clear();
+    m_count = -1;
+    m_sections.clear();
+}
+
+void QIviPagingModelSharedCache::evictChunks()
+{
+    //Don't keep more chunks than the member with the biggest cache, unless one of them keeps all chunks
+    int limit = 0;
+    for (QIviPagingModelPrivate *member : qAsConst(m_members)) {
+        const int cacheLimit = member->m_chunkCache.cacheLimit();
+        if (cacheLimit <= 0)
+            return;
+        limit = qMax(limit, cacheLimit);
+    }
+
+    while (m_chunkOrder.count() > limit)
+        m_chunks.remove(m_chunkOrder.takeFirst());
+}
+
+/*!
+    \class QIviPagingModel
+    \inmodule QtIviCore
+    \brief The QIviPagingModel is a generic model to load its data using the "Paging" aproach.
+
+    The QIviPagingModel should be used directly or as a base class whenever a lot of data needs to be
+    presented in a ListView.
+
+    The model only fetches the data it really needs and can it can be configured how this can be done using
+    the loadingType property.
+
+    The backend filling the model with data needs to implement the QIviPagingModelInterface class.
+
+    \section1 Setting it up
+    The QIviPagingModel is using QtIviCore's \l {Dynamic Backend System} and is derived from QIviAbstractFeatureListModel.
+    Other than most "QtIvi Feature classes", the QIviPagingModel doesn't automatically connect to available backends.
+
+    The easiest approach to set it up, is to connect to the same backend used by another feature. E.g. for connecting to the
+    media backend, use the instance from the mediaplayer feature:
+    \code
+        QIviMediaPlayer *player = new QIviMediaPlayer();
+        player->startAutoDiscovery();
+        QIviPagingModel *model = new QIviPagingModel();
+        model->setServiceObject(player->serviceObject());
+    \endcode
+
+    \section1 Loading Types
+
+    Multiple loading types are supported, as the QIviPagingModel is made to work with asynchronous requests to
+    fetch its data. The FetchMore loading type is the default and is using the \l{QAbstractItemModel::}{canFetchMore()}/\l{QAbstractItemModel::}{fetchMore()} functions of
+    QAbstractItemModel to fetch new data once the view hits the end of the currently available data. As fetching can take
+    some time, there is the fetchMoreThreshold property which controls how much in advance a new fetch should be started.
+
+    The other loading type is DataChanged. In contrast to FetchMore, the complete model is pre-populated with empty rows
+    and the actual data for a specific row is fetched the first time the data() function is called. Once the data is available,
+    the dataChanged() signal will be triggered for this row and the view will start to render the new data.
+
+    Please see the documentation of \l{QIviPagingModel::}{LoadingType} for more details on how the modes work and
+    when they are suitable to use.
+
+    See the \l{Models} section for more information about all models in QtIvi.
+*/
+
+/*!
+    \enum QIviPagingModel::LoadingType
+    \value FetchMore
+           This is the default and can be used if you don't know the final size of the list (e.g. a infinite list).
+           The list will detect that it is near the end (fetchMoreThreshold) and then fetch the next chunk of data using canFetchMore and fetchMore.
+           The drawback of this method is that you can't display a dynamic scroll-bar indicator which is resized depending on the content of the list,
+           because the final size of the data is not known.
+           The other problem could be fast scrolling, as the data might not arrive in-time and scrolling stops. This can be tweaked by the fetchMoreThreshold property.
+
+    \value DataChanged
+           For this loading type you need to know how many items are in the list, as dummy items are created and the user can already start scrolling even though the data is not yet ready to be displayed.
+           Similar to FetchMore, the data is also loaded in chunks. You can safely use a scroll indicator here.
+           The delegate needs to support this approach, as it doesn't have content when it's first created.
+*/
+
+/*!
+    \enum QIviPagingModel::Roles
+    \value NameRole
+          The name of the item. E.g. The name of a contact in a addressbook, or the artist-name in a list of artists.
+    \value TypeRole
+          The type of the item. E.g. "artist", "track", "contact".
+    \value ItemRole
+          The item itself. This provides access to the properties which are type specific. E.g. the address of a contact.
+    \omitvalue LastRole
+*/
+
+/*!
+    \qmltype PagingModel
+    \instantiates QIviPagingModel
+    \inqmlmodule QtIvi
+    \inherits AbstractFeatureListModel
+    \brief The PagingModel is a generic model to load its data using the "Paging" aproach.
+
+    The PagingModel should be used directly or as a base class whenever a lot of data needs to be
+    presented in a ListView.
+
+    The model only fetches the data it really needs and can it can be configured how this can be done using
+    the loadingType property.
+
+    All rows in the model need to be subclassed from StandardItem.
+
+    The following roles are available in this model:
+
+    \table
+    \header
+        \li Role name
+        \li Type
+        \li Description
+    \row
+        \li \c name
+        \li string
+        \li The name of the item. E.g. The name of a contact in a addressbook, or the artist-name in a list of artists.
+    \row
+        \li \c type
+        \li string
+        \li The type of the item. E.g. "artist", "track", "contact".
+    \row
+        \li \c item
+        \li object
+        \li The item itself. This provides access to the properties which are type specific. E.g. the address of a contact.
+    \endtable
+
+    \section1 Setting it up
+    The PagingModel is using QtIviCore's \l {Dynamic Backend System} and is derived from QIviAbstractFeatureListModel.
+    Other than most "QtIvi Feature classes", the PagingModel doesn't automatically connect to available backends.
+
+    The easiest approach to set it up, is to connect to the same backend used by another feature. E.g. for connecting to the
+    media backend, use the instance from the mediaplayer feature:
+    \qml
+        Item {
+            MediaPlayer {
+                id: player
+            }
+
+            PagingModel {
+                serviceObject: player.serviceObject
+            }
+        }
+    \endqml
+
+    \section1 Loading Types
+
+    Multiple loading types are supported, as the PagingModel is made to work with asynchronous requests to
+    fetch its data. The FetchMore loading type is the default and is using the \l{QAbstractItemModel::}{canFetchMore()}/\l{QAbstractItemModel::}{fetchMore()} functions of
+    QAbstractItemModel to fetch new data once the view hits the end of the currently available data. As fetching can take
+    some time, there is the fetchMoreThreshold property which controls how much in advance a new fetch should be started.
+
+    The other loading type is DataChanged. In contrast to FetchMore, the complete model is pre-populated with empty rows
+    and the actual data for a specific row is fetched the first time the data() function is called. Once the data is available,
+    the dataChanged() signal will be triggered for this row and the view will start to render the new data.
+
+    Please see the documentation of loadingType for more details on how the modes work and
+    when they are suitable to use.
+
+    See the \l{Models} section for more information about all models in QtIvi.
+*/
+
+/*!
+    Constructs a QIviPagingModel.
+
+    The \a parent argument is passed on to the \l QIviAbstractFeatureListModel base class.
+*/
+QIviPagingModel::QIviPagingModel(QObject *parent)
+    : QIviAbstractFeatureListModel(*new QIviPagingModelPrivate(QStringLiteral(QIviPagingModel_iid), this), parent)
+{
+}
+
+/*!
+    \qmlproperty enumeration PagingModel::capabilities
+    \brief Holds the capabilities of the backend.
+
+    The capabilities controls what the backend supports.
+    It can be a combination of the following values:
+
+    \value NoExtras
+           The backend does only support the minimum feature set and is stateful.
+    \value SupportsGetSize
+           The backend can return the final number of items for a specific request. This makes it possible to support the QIviPagingModel::DataChanged loading
+           type.
+    \value SupportsFiltering
+           The backend supports filtering of the content. QIviSearchAndBrowseModelInterface::availableContentTypesChanged() and QIviSearchAndBrowseModelInterface::queryIdentifiersChanged() will be used as input for the
+           \l {Qt IVI Query Language}.
+    \value SupportsSorting
+           The backend supports sorting of the content. QIviSearchAndBrowseModelInterface::availableContentTypesChanged() and QIviSearchAndBrowseModelInterface::queryIdentifiersChanged() will be used as input for the
+           \l {Qt IVI Query Language}.
+    \value SupportsAndConjunction
+           The backend supports handling multiple filters at the same time and these filters can be combined by using the AND conjunction.
+    \value SupportsOrConjunction
+           The backend supports handling multiple filters at the same time and these filters can be combined by using the OR conjunction.
+    \value SupportsStatelessNavigation
+           The backend is stateless and supports handling multiple instances of a QIviSearchAndBrowseModel requesting different data at the same time.
+           E.g. One request for artists, sorted by name and another request for tracks. The backend has to consider that both request come from models which are
+           currently visible at the same time.
+    \value SupportsInsert
+           The backend supports inserting new items at a given position.
+    \value SupportsMove
+           The backend supports moving items within the model.
+    \value SupportsRemove
+           The backend supports removing items from the model.
+    \value SupportsSectionIndex
+           The backend reports the sections of the content in its current order. See QIviSearchAndBrowseModelInterface::sectionsChanged().
+*/
+
+/*!
+    \property QIviPagingModel::capabilities
+    \brief Holds the capabilities of the backend for the current content of the model.
+
+    The capabilities controls what the current contentType supports. e.g. filtering or sorting.
+*/
+
+QtIviCoreModule::ModelCapabilities QIviPagingModel::capabilities() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_capabilities;
+}
+
+/*!
+    \qmlproperty int PagingModel::chunkSize
+    \brief Holds the number of rows which are requested from the backend interface.
+
+    This property can be used to fine tune the loading performance.
+
+    Bigger chunks means less calls to the backend and to a potential IPC underneath, but more data
+    to be transferred and probably longer waiting time until the request was finished.
+*/
+
+/*!
+    \property QIviPagingModel::chunkSize
+    \brief Holds the number of rows which are requested from the backend interface.
+
+    This property can be used to fine tune the loading performance.
+
+    Bigger chunks means less calls to the backend and to a potential IPC underneath, but more data
+    to be transferred and probably longer waiting time until the request was finished.
+*/
+int QIviPagingModel::chunkSize() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_chunkSize;
+}
+
+void QIviPagingModel::setChunkSize(int chunkSize)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_chunkSize == chunkSize)
+        return;
+
+    d->m_chunkSize = chunkSize;
+    emit chunkSizeChanged(chunkSize);
+
+    d->m_chunkCache.rebuild();
+    d->updateSharedCache();
+}
+
+/*!
+    \qmlproperty int PagingModel::fetchMoreThreshold
+    \brief Holds the row delta to the end before the next chunk is loaded
+
+    This property can be used to fine tune the loading performance. When the
+    threshold is reached the next chunk of rows are requested from the backend. How many rows are fetched
+    can be defined by using the chunkSize property.
+
+    The threshold defines the number of rows before the cached rows ends.
+
+    \note This property is only used when loadingType is set to FetchMore.
+*/
+
+/*!
+    \property QIviPagingModel::fetchMoreThreshold
+    \brief Holds the row delta to the end before the next chunk is loaded
+
+    This property can be used to fine tune the loading performance. When the
+    threshold is reached the next chunk of rows are requested from the backend. How many rows are fetched
+    can be defined by using the chunkSize property.
+
+    The threshold defines the number of rows before the cached rows ends.
+
+    \note This property is only used when loadingType is set to FetchMore.
+*/
+int QIviPagingModel::fetchMoreThreshold() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_fetchMoreThreshold;
+}
+
+void QIviPagingModel::setFetchMoreThreshold(int fetchMoreThreshold)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_fetchMoreThreshold == fetchMoreThreshold)
+        return;
+
+    d->m_fetchMoreThreshold = fetchMoreThreshold;
+    emit fetchMoreThresholdChanged(fetchMoreThreshold);
+}
+
+/*!
+    \qmlproperty int PagingModel::cacheLimit
+    \brief Holds the maximum number of chunks which are kept in memory.
+
+    Once more chunks than the limit have been fetched, the least recently used chunks are removed
+    from the cache. The rows of a removed chunk stay in the model, but their data is fetched again
+    from the backend the next time it is needed.
+
+    The limit should be bigger than the number of chunks which are visible at the same time.
+    The default value is 0, which means that all fetched chunks are kept in memory.
+*/
+
+/*!
+    \property QIviPagingModel::cacheLimit
+    \brief Holds the maximum number of chunks which are kept in memory.
+
+    Once more chunks than the limit have been fetched, the least recently used chunks are removed
+    from the cache. The rows of a removed chunk stay in the model, but their data is fetched again
+    from the backend the next time it is needed.
+
+    The limit should be bigger than the number of chunks which are visible at the same time.
+    The default value is 0, which means that all fetched chunks are kept in memory.
+*/
+int QIviPagingModel::cacheLimit() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_chunkCache.cacheLimit();
+}
+
+void QIviPagingModel::setCacheLimit(int cacheLimit)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_chunkCache.cacheLimit() == cacheLimit)
+        return;
+
+    d->m_chunkCache.setCacheLimit(cacheLimit);
+    emit cacheLimitChanged(cacheLimit);
+}
+
+/*!
+    \qmlproperty int PagingModel::prefetchDistance
+    \brief Holds the number of chunks which are fetched ahead of the visible rows.
+
+    The visible rows are either set explicitly using setViewport() or inferred from the rows
+    requested by the view. Whenever the view enters a new chunk, the next \e prefetchDistance
+    chunks in the scroll direction and one chunk in the opposite direction are fetched in advance.
+    If the view skipped whole chunks since the last access, e.g. during a flick, the distance is
+    doubled.
+
+    If a cacheLimit is set, the number of prefetched chunks is reduced to make sure the visible
+    chunks are not evicted from the cache.
+
+    The default value is 0, which disables prefetching.
+*/
+
+/*!
+    \property QIviPagingModel::prefetchDistance
+    \brief Holds the number of chunks which are fetched ahead of the visible rows.
+
+    The visible rows are either set explicitly using setViewport() or inferred from the rows
+    requested by the view. Whenever the view enters a new chunk, the next \e prefetchDistance
+    chunks in the scroll direction and one chunk in the opposite direction are fetched in advance.
+    If the view skipped whole chunks since the last access, e.g. during a flick, the distance is
+    doubled.
+
+    If a cacheLimit is set, the number of prefetched chunks is reduced to make sure the visible
+    chunks are not evicted from the cache.
+
+    The default value is 0, which disables prefetching.
+*/
+int QIviPagingModel::prefetchDistance() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_prefetchDistance;
+}
+
+void QIviPagingModel::setPrefetchDistance(int prefetchDistance)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_prefetchDistance == prefetchDistance)
+        return;
+
+    d->m_prefetchDistance = prefetchDistance;
+    emit prefetchDistanceChanged(prefetchDistance);
+}
+
+/*!
+    \qmlproperty bool PagingModel::adaptiveChunkSize
+    \brief Holds whether the chunk size is adapted to the measured fetch performance.
+
+    If enabled, the time needed by the backend to return the data is measured for every fetch and
+    used to estimate the fixed latency of a request (fetchLatency) and the time needed per row
+    (rowFetchCost). The chunkSize is then chosen to make the fixed latency at most half of the time
+    needed for a chunk, without letting a single fetch take longer than 100 milliseconds. The
+    chunk size always stays between minimumChunkSize and maximumChunkSize.
+
+    The default value is \c false.
+*/
+
+/*!
+    \property QIviPagingModel::adaptiveChunkSize
+    \brief Holds whether the chunk size is adapted to the measured fetch performance.
+
+    If enabled, the time needed by the backend to return the data is measured for every fetch and
+    used to estimate the fixed latency of a request (fetchLatency) and the time needed per row
+    (rowFetchCost). The chunkSize is then chosen to make the fixed latency at most half of the time
+    needed for a chunk, without letting a single fetch take longer than 100 milliseconds. The
+    chunk size always stays between minimumChunkSize and maximumChunkSize.
+
+    The default value is \c false.
+*/
+bool QIviPagingModel::adaptiveChunkSize() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_adaptiveChunkSize;
+}
+
+void QIviPagingModel::setAdaptiveChunkSize(bool adaptiveChunkSize)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_adaptiveChunkSize == adaptiveChunkSize)
+        return;
+
+    d->m_adaptiveChunkSize = adaptiveChunkSize;
+    emit adaptiveChunkSizeChanged(adaptiveChunkSize);
+}
+
+/*!
+    \qmlproperty int PagingModel::minimumChunkSize
+    \brief Holds the smallest chunk size used when adaptiveChunkSize is enabled.
+
+    The default value is 10.
+*/
+
+/*!
+    \property QIviPagingModel::minimumChunkSize
+    \brief Holds the smallest chunk size used when adaptiveChunkSize is enabled.
+
+    The default value is 10.
+*/
+int QIviPagingModel::minimumChunkSize() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_minimumChunkSize;
+}
+
+void QIviPagingModel::setMinimumChunkSize(int minimumChunkSize)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_minimumChunkSize == minimumChunkSize)
+        return;
+
+    d->m_minimumChunkSize = minimumChunkSize;
+    emit minimumChunkSizeChanged(minimumChunkSize);
+}
+
+/*!
+    \qmlproperty int PagingModel::maximumChunkSize
+    \brief Holds the biggest chunk size used when adaptiveChunkSize is enabled.
+
+    The default value is 500.
+*/
+
+/*!
+    \property QIviPagingModel::maximumChunkSize
+    \brief Holds the biggest chunk size used when adaptiveChunkSize is enabled.
+
+    The default value is 500.
+*/
+int QIviPagingModel::maximumChunkSize() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_maximumChunkSize;
+}
+
+void QIviPagingModel::setMaximumChunkSize(int maximumChunkSize)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_maximumChunkSize == maximumChunkSize)
+        return;
+
+    d->m_maximumChunkSize = maximumChunkSize;
+    emit maximumChunkSizeChanged(maximumChunkSize);
+}
+
+/*!
+    \qmlproperty real PagingModel::fetchLatency
+    \readonly
+    \brief Holds the measured fixed latency of a fetch in milliseconds.
 
-    The backend filling the model with data needs to implement the QIviPagingModelInterface class.
+    The latency is estimated from the recent fetches and is independent of the number of fetched
+    rows. It is only available once fetches with a different number of rows have been measured.
 
-    \section1 Setting it up
-    The QIviPagingModel is using QtIviCore's \l {Dynamic Backend System} and is derived from QIviAbstractFeatureListModel.
-    Other than most "QtIvi Feature classes", the QIviPagingModel doesn't automatically connect to available backends.
+    \sa rowFetchCost
+*/
 
-    The easiest approach to set it up, is to connect to the same backend used by another feature. E.g. for connecting to the
-    media backend, use the instance from the mediaplayer feature:
-    \code
-        QIviMediaPlayer *player = new QIviMediaPlayer();
-        player->startAutoDiscovery();
-        QIviPagingModel *model = new QIviPagingModel();
-        model->setServiceObject(player->serviceObject());
-    \endcode
+/*!
+    \property QIviPagingModel::fetchLatency
+    \brief Holds the measured fixed latency of a fetch in milliseconds.
 
-    \section1 Loading Types
+    The latency is estimated from the recent fetches and is independent of the number of fetched
+    rows. It is only available once fetches with a different number of rows have been measured.
 
-    Multiple loading types are supported, as the QIviPagingModel is made to work with asynchronous requests to
-    fetch its data. The FetchMore loading type is the default and is using the \l{QAbstractItemModel::}{canFetchMore()}/\l{QAbstractItemModel::}{fetchMore()} functions of
-    QAbstractItemModel to fetch new data once the view hits the end of the currently available data. As fetching can take
-    some time, there is the fetchMoreThreshold property which controls how much in advance a new fetch should be started.
+    \sa rowFetchCost
+*/
+qreal QIviPagingModel::fetchLatency() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_fetchLatency;
+}
 
-    The other loading type is DataChanged. In contrast to FetchMore, the complete model is pre-populated with empty rows
-    and the actual data for a specific row is fetched the first time the data() function is called. Once the data is available,
-    the dataChanged() signal will be triggered for this row and the view will start to render the new data.
+/*!
+    \qmlproperty real PagingModel::rowFetchCost
+    \readonly
+    \brief Holds the measured time needed to fetch a single row in milliseconds.
 
-    Please see the documentation of \l{QIviPagingModel::}{LoadingType} for more details on how the modes work and
-    when they are suitable to use.
+    The cost is estimated from the recent fetches in addition to the fixed fetchLatency.
 
-    See the \l{Models} section for more information about all models in QtIvi.
+    \sa fetchLatency
 */
 
 /*!
-    \enum QIviPagingModel::LoadingType
-    \value FetchMore
-           This is the default and can be used if you don't know the final size of the list (e.g. a infinite list).
-           The list will detect that it is near the end (fetchMoreThreshold) and then fetch the next chunk of data using canFetchMore and fetchMore.
-           The drawback of this method is that you can't display a dynamic scroll-bar indicator which is resized depending on the content of the list,
-           because the final size of the data is not known.
-           The other problem could be fast scrolling, as the data might not arrive in-time and scrolling stops. This can be tweaked by the fetchMoreThreshold property.
+    \property QIviPagingModel::rowFetchCost
+    \brief Holds the measured time needed to fetch a single row in milliseconds.
 
-    \value DataChanged
-           For this loading type you need to know how many items are in the list, as dummy items are created and the user can already start scrolling even though the data is not yet ready to be displayed.
-           Similar to FetchMore, the data is also loaded in chunks. You can safely use a scroll indicator here.
-           The delegate needs to support this approach, as it doesn't have content when it's first created.
+    The cost is estimated from the recent fetches in addition to the fixed fetchLatency.
+
+    \sa fetchLatency
 */
+qreal QIviPagingModel::rowFetchCost() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_rowFetchCost;
+}
 
 /*!
-    \enum QIviPagingModel::Roles
-    \value NameRole
-          The name of the item. E.g. The name of a contact in a addressbook, or the artist-name in a list of artists.
-    \value TypeRole
-          The type of the item. E.g. "artist", "track", "contact".
-    \value ItemRole
-          The item itself. This provides access to the properties which are type specific. E.g. the address of a contact.
-    \omitvalue LastRole
+    \qmlproperty int PagingModel::snapshotChunkCount
+    \brief Holds the number of chunks which are stored in an on-disk snapshot.
+
+    If set, the first \e snapshotChunkCount chunks of the model are written to a snapshot in the
+    cache location of the application once they got fetched. The writes are collected for a second
+    and done at the latest when the model is reset or deleted. When the model is reset the next
+    time, e.g. after a restart of the application, the rows are restored from this snapshot
+    immediately and the view doesn't need to wait for the backend. The restored chunks are fetched
+    again right away and only the rows whose id, name, type or data changed in the meantime are
+    updated.
+
+    The snapshot is identified by the backend and, for a SearchAndBrowseModel, by the content type
+    and the query. Items can only be stored if stream operators are registered for their type.
+    This is done for StandardItem, PlayableItem and AudioTrackItem already, custom item types need
+    to be registered using qRegisterMetaTypeStreamOperators().
+
+    The default value is 0, which disables the snapshot.
 */
 
 /*!
-    \qmltype PagingModel
-    \instantiates QIviPagingModel
-    \inqmlmodule QtIvi
-    \inherits AbstractFeatureListModel
-    \brief The PagingModel is a generic model to load its data using the "Paging" aproach.
-
-    The PagingModel should be used directly or as a base class whenever a lot of data needs to be
-    presented in a ListView.
+    \property QIviPagingModel::snapshotChunkCount
+    \brief Holds the number of chunks which are stored in an on-disk snapshot.
+
+    If set, the first \e snapshotChunkCount chunks of the model are written to a snapshot in the
+    cache location of the application once they got fetched. The writes are collected for a second
+    and done at the latest when the model is reset or deleted. When the model is reset the next
+    time, e.g. after a restart of the application, the rows are restored from this snapshot
+    immediately and the view doesn't need to wait for the backend. The restored chunks are fetched
+    again right away and only the rows whose id, name, type or data changed in the meantime are
+    updated.
+
+    The snapshot is identified by the backend and, for a SearchAndBrowseModel, by the content type
+    and the query. Items can only be stored if stream operators are registered for their type.
+    This is done for QIviStandardItem, QIviPlayableItem and QIviAudioTrackItem already, custom item types need
+    to be registered using qRegisterMetaTypeStreamOperators().
+
+    The default value is 0, which disables the snapshot.
+*/
+int QIviPagingModel::snapshotChunkCount() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_snapshotChunkCount;
+}
 
-    The model only fetches the data it really needs and can it can be configured how this can be done using
-    the loadingType property.
+void QIviPagingModel::setSnapshotChunkCount(int snapshotChunkCount)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_snapshotChunkCount == snapshotChunkCount)
+        return;
 
-    All rows in the model need to be subclassed from StandardItem.
+    d->m_snapshotChunkCount = snapshotChunkCount;
+    emit snapshotChunkCountChanged(snapshotChunkCount);
+}
 
-    The following roles are available in this model:
+/*!
+    \qmlproperty bool PagingModel::incrementalReload
+    \brief Holds whether the model keeps its rows when it is reloaded.
 
-    \table
-    \header
-        \li Role name
-        \li Type
-        \li Description
-    \row
-        \li \c name
-        \li string
-        \li The name of the item. E.g. The name of a contact in a addressbook, or the artist-name in a list of artists.
-    \row
-        \li \c type
-        \li string
-        \li The type of the item. E.g. "artist", "track", "contact".
-    \row
-        \li \c item
-        \li object
-        \li The item itself. This provides access to the properties which are type specific. E.g. the address of a contact.
-    \endtable
+    By default, reloading the model, e.g. by calling reload() or by changing the query of a
+    SearchAndBrowseModel, resets the model. All delegates are recreated and the view jumps to the
+    beginning.
 
-    \section1 Setting it up
-    The PagingModel is using QtIviCore's \l {Dynamic Backend System} and is derived from QIviAbstractFeatureListModel.
-    Other than most "QtIvi Feature classes", the PagingModel doesn't automatically connect to available backends.
+    If enabled, the existing rows are kept while all chunks up to the last visible row are fetched
+    again. Once the new data arrived, it is matched with the existing rows by the \c id of the items
+    and only the rows which were removed, inserted, moved or changed are reported to the view. The
+    rows behind the reloaded chunks are fetched again once they are needed.
 
-    The easiest approach to set it up, is to connect to the same backend used by another feature. E.g. for connecting to the
-    media backend, use the instance from the mediaplayer feature:
-    \qml
-        Item {
-            MediaPlayer {
-                id: player
-            }
+    Rows without an id can't be matched and are always replaced.
 
-            PagingModel {
-                serviceObject: player.serviceObject
-            }
-        }
-    \endqml
+    \note Changing the loadingType always resets the model.
 
-    \section1 Loading Types
+    The default value is false.
+*/
 
-    Multiple loading types are supported, as the PagingModel is made to work with asynchronous requests to
-    fetch its data. The FetchMore loading type is the default and is using the \l{QAbstractItemModel::}{canFetchMore()}/\l{QAbstractItemModel::}{fetchMore()} functions of
-    QAbstractItemModel to fetch new data once the view hits the end of the currently available data. As fetching can take
-    some time, there is the fetchMoreThreshold property which controls how much in advance a new fetch should be started.
+/*!
+    \property QIviPagingModel::incrementalReload
+    \brief Holds whether the model keeps its rows when it is reloaded.
 
-    The other loading type is DataChanged. In contrast to FetchMore, the complete model is pre-populated with empty rows
-    and the actual data for a specific row is fetched the first time the data() function is called. Once the data is available,
-    the dataChanged() signal will be triggered for this row and the view will start to render the new data.
+    By default, reloading the model, e.g. by calling reload() or by changing the query of a
+    QIviSearchAndBrowseModel, resets the model. All delegates are recreated and the view jumps to
+    the beginning.
 
-    Please see the documentation of loadingType for more details on how the modes work and
-    when they are suitable to use.
+    If enabled, the existing rows are kept while all chunks up to the last visible row are fetched
+    again. Once the new data arrived, it is matched with the existing rows by the QIviStandardItem::id
+    and only the rows which were removed, inserted, moved or changed are reported to the view. The
+    rows behind the reloaded chunks are fetched again once they are needed.
 
-    See the \l{Models} section for more information about all models in QtIvi.
-*/
+    Rows without an id can't be matched and are always replaced.
 
-/*!
-    Constructs a QIviPagingModel.
+    \note Changing the loadingType always resets the model.
 
-    The \a parent argument is passed on to the \l QIviAbstractFeatureListModel base class.
+    The default value is false.
 */
-QIviPagingModel::QIviPagingModel(QObject *parent)
-    : QIviAbstractFeatureListModel(*new QIviPagingModelPrivate(QStringLiteral(QIviPagingModel_iid), this), parent)
+bool QIviPagingModel::incrementalReload() const
+{
+    Q_D(const QIviPagingModel);
+    return d->m_incrementalReload;
+}
+
+void QIviPagingModel::setIncrementalReload(bool incrementalReload)
 {
+    Q_D(QIviPagingModel);
+    if (d->m_incrementalReload == incrementalReload)
+        return;
+
+    d->m_incrementalReload = incrementalReload;
+    emit incrementalReloadChanged(incrementalReload);
 }
 
 /*!
-    \qmlproperty enumeration PagingModel::capabilities
-    \brief Holds the capabilities of the backend.
+    \qmlproperty bool PagingModel::backgroundDecoding
+    \brief Holds whether the fetched chunks are converted on a worker thread.
 
-    The capabilities controls what the backend supports.
-    It can be a combination of the following values:
+    If enabled, the conversion of the fetched items into the rows of the model, e.g. extracting the
+    name and the type of every item, is done on a worker thread. Once a chunk is converted, all its
+    rows are inserted with a single queued call. This keeps the work done on the GUI thread while
+    scrolling to a minimum, especially for big chunks or remote backends.
 
-    \value NoExtras
-           The backend does only support the minimum feature set and is stateful.
-    \value SupportsGetSize
-           The backend can return the final number of items for a specific request. This makes it possible to support the QIviPagingModel::DataChanged loading
-           type.
-    \value SupportsFiltering
-           The backend supports filtering of the content. QIviSearchAndBrowseModelInterface::availableContentTypesChanged() and QIviSearchAndBrowseModelInterface::queryIdentifiersChanged() will be used as input for the
-           \l {Qt IVI Query Language}.
-    \value SupportsSorting
-           The backend supports sorting of the content. QIviSearchAndBrowseModelInterface::availableContentTypesChanged() and QIviSearchAndBrowseModelInterface::queryIdentifiersChanged() will be used as input for the
-           \l {Qt IVI Query Language}.
-    \value SupportsAndConjunction
-           The backend supports handling multiple filters at the same time and these filters can be combined by using the AND conjunction.
-    \value SupportsOrConjunction
-           The backend supports handling multiple filters at the same time and these filters can be combined by using the OR conjunction.
-    \value SupportsStatelessNavigation
-           The backend is stateless and supports handling multiple instances of a QIviSearchAndBrowseModel requesting different data at the same time.
-           E.g. One request for artists, sorted by name and another request for tracks. The backend has to consider that both request come from models which are
-           currently visible at the same time.
-    \value SupportsInsert
-           The backend supports inserting new items at a given position.
-    \value SupportsMove
-           The backend supports moving items within the model.
-    \value SupportsRemove
-           The backend supports removing items from the model.
+    The fetched rows appear with a small delay, as they need to be passed to the worker thread
+    and back. All other updates from the backend are delayed as well, to keep their order.
+
+    The default value is false.
 */
 
 /*!
-    \property QIviPagingModel::capabilities
-    \brief Holds the capabilities of the backend for the current content of the model.
+    \property QIviPagingModel::backgroundDecoding
+    \brief Holds whether the fetched chunks are converted on a worker thread.
 
-    The capabilities controls what the current contentType supports. e.g. filtering or sorting.
-*/
+    If enabled, the conversion of the fetched items into the rows of the model, e.g. extracting the
+    name and the type of every item, is done on a worker thread. Once a chunk is converted, all its
+    rows are inserted with a single queued call. This keeps the work done on the GUI thread while
+    scrolling to a minimum, especially for big chunks or remote backends.
 
-QtIviCoreModule::ModelCapabilities QIviPagingModel::capabilities() const
+    The fetched rows appear with a small delay, as they need to be passed to the worker thread
+    and back. All other updates from the backend are delayed as well, to keep their order.
+
+    The default value is false.
+*/
+bool QIviPagingModel::backgroundDecoding() const
 {
     Q_D(const QIviPagingModel);
-    return d->m_capabilities;
+    return d->m_backgroundDecoding;
+}
+
+void QIviPagingModel::setBackgroundDecoding(bool backgroundDecoding)
+{
+    Q_D(QIviPagingModel);
+    if (d->m_backgroundDecoding == backgroundDecoding)
+        return;
+
+    d->m_backgroundDecoding = backgroundDecoding;
+    emit backgroundDecodingChanged(backgroundDecoding);
 }
 
 /*!
-    \qmlproperty int PagingModel::chunkSize
-    \brief Holds the number of rows which are requested from the backend interface.
+    \qmlproperty bool PagingModel::sharedCache
+    \brief Holds whether the fetched chunks are shared with other models using the same query.
 
-    This property can be used to fine tune the loading performance.
+    If enabled, all models with this property set, which are connected to the same backend and use
+    the same query, chunkSize and loadingType, share the chunks fetched from the backend.
+    A chunk which was already fetched by one of these models is used right away and a chunk which is
+    currently requested by one of them is not requested again. Every model still keeps its own rows
+    and can be scrolled independently.
 
-    Bigger chunks means less calls to the backend and to a potential IPC underneath, but more data
-    to be transferred and probably longer waiting time until the request was finished.
+    The shared chunks are dropped once the backend reports changed data, reload() is called or the
+    last model using them is destroyed.
+
+    \note The chunks are only shared if the backend reports the
+    \l {QtIviCoreModule::ModelCapability}{SupportsSharedResults} capability. Backends which keep a
+    state per instance, e.g. to implement \l {SearchAndBrowseModel::goForward}{goForward()}, can't answer the requests of other
+    instances and don't report it. For them this property has no effect.
+
+    The default value is false.
 */
 
 /*!
-    \property QIviPagingModel::chunkSize
-    \brief Holds the number of rows which are requested from the backend interface.
+    \property QIviPagingModel::sharedCache
+    \brief Holds whether the fetched chunks are shared with other models using the same query.
 
-    This property can be used to fine tune the loading performance.
+    If enabled, all models with this property set, which are connected to the same backend and use
+    the same query, chunkSize and loadingType, share the chunks fetched from the backend.
+    A chunk which was already fetched by one of these models is used right away and a chunk which is
+    currently requested by one of them is not requested again. Every model still keeps its own rows
+    and can be scrolled independently.
 
-    Bigger chunks means less calls to the backend and to a potential IPC underneath, but more data
-    to be transferred and probably longer waiting time until the request was finished.
+    The shared chunks are dropped once the backend reports changed data, reload() is called or the
+    last model using them is destroyed.
+
+    \note The chunks are only shared if the backend reports the
+    \l {QtIviCoreModule::ModelCapability}{SupportsSharedResults} capability. Backends which keep a
+    state per instance, e.g. to implement QIviSearchAndBrowseModel::goForward(), can't answer the requests of other
+    instances and don't report it. For them this property has no effect.
+
+    The default value is false.
 */
-int QIviPagingModel::chunkSize() const
+bool QIviPagingModel::sharedCache() const
 {
     Q_D(const QIviPagingModel);
-    return d->m_chunkSize;
+    return d->m_sharedCacheEnabled;
 }
 
-void QIviPagingModel::setChunkSize(int chunkSize)
+void QIviPagingModel::setSharedCache(bool sharedCache)
 {
     Q_D(QIviPagingModel);
-    if (d->m_chunkSize == chunkSize)
+    if (d->m_sharedCacheEnabled == sharedCache)
         return;
 
-    d->m_chunkSize = chunkSize;
-    emit chunkSizeChanged(chunkSize);
+    d->m_sharedCacheEnabled = sharedCache;
+    emit sharedCacheChanged(sharedCache);
+
+    d->updateSharedCache();
 }
 
 /*!
-    \qmlproperty int PagingModel::fetchMoreThreshold
-    \brief Holds the row delta to the end before the next chunk is loaded
+    \qmlproperty bool PagingModel::statisticsEnabled
+    \brief Holds whether the cache accesses of the model are counted for the statistics.
 
-    This property can be used to fine tune the loading performance. When the
-    threshold is reached the next chunk of rows are requested from the backend. How many rows are fetched
-    can be defined by using the chunkSize property.
+    If enabled, every access to the data of the model is counted as a cache hit or miss and the
+    statisticsChanged signal is emitted whenever the statistics change. As this adds some work to
+    every call of data(), it should only be enabled while the statistics are shown, e.g. by a
+    debug overlay.
 
-    The threshold defines the number of rows before the cached rows ends.
+    The fetches, evictions and decoded chunks are counted in any case.
 
-    \note This property is only used when loadingType is set to FetchMore.
+    The default value is false.
 */
 
 /*!
-    \property QIviPagingModel::fetchMoreThreshold
-    \brief Holds the row delta to the end before the next chunk is loaded
+    \property QIviPagingModel::statisticsEnabled
+    \brief Holds whether the cache accesses of the model are counted for the statistics.
 
-    This property can be used to fine tune the loading performance. When the
-    threshold is reached the next chunk of rows are requested from the backend. How many rows are fetched
-    can be defined by using the chunkSize property.
+    If enabled, every access to the data of the model is counted as a cache hit or miss and the
+    statisticsChanged signal is emitted whenever the statistics change. As this adds some work to
+    every call of data(), it should only be enabled while the statistics are shown, e.g. by a
+    debug overlay.
 
-    The threshold defines the number of rows before the cached rows ends.
+    The fetches, evictions and decoded chunks are counted in any case.
 
-    \note This property is only used when loadingType is set to FetchMore.
+    The default value is false.
 */
-int QIviPagingModel::fetchMoreThreshold() const
+bool QIviPagingModel::statisticsEnabled() const
 {
     Q_D(const QIviPagingModel);
-    return d->m_fetchMoreThreshold;
+    return d->m_statisticsEnabled;
 }
 
-void QIviPagingModel::setFetchMoreThreshold(int fetchMoreThreshold)
+void QIviPagingModel::setStatisticsEnabled(bool statisticsEnabled)
 {
     Q_D(QIviPagingModel);
-    if (d->m_fetchMoreThreshold == fetchMoreThreshold)
+    if (d->m_statisticsEnabled == statisticsEnabled)
         return;
 
-    d->m_fetchMoreThreshold = fetchMoreThreshold;
-    emit fetchMoreThresholdChanged(fetchMoreThreshold);
+    d->m_statisticsEnabled = statisticsEnabled;
+    emit statisticsEnabledChanged(statisticsEnabled);
+}
+
+/*!
+    \qmlproperty PagingModelStatistics PagingModel::statistics
+    \brief Holds the cache and fetch statistics of this model.
+
+    The statistics contain the cache hits and misses per role, the outstanding fetches, a histogram
+    of the fetch latencies, the rows held in memory and the evicted chunks. They can be used by a
+    debug overlay to tune properties like chunkSize, cacheLimit or prefetchDistance.
+
+    The cache hits and misses are only counted and the change signal is only emitted while
+    statisticsEnabled is set. As the statistics change with every access to the data of the model, the
+    change signal is emitted at most once per event loop iteration. More details about every
+    fetch, cache miss and eviction are logged using the \c qt.ivi.pagingmodel logging category.
+
+    \sa PagingModelStatistics
+*/
+
+/*!
+    \property QIviPagingModel::statistics
+    \brief Holds the cache and fetch statistics of this model.
+
+    The statistics contain the cache hits and misses per role, the outstanding fetches, a histogram
+    of the fetch latencies, the rows held in memory and the evicted chunks. They can be used by a
+    debug overlay to tune properties like chunkSize, cacheLimit or prefetchDistance.
+
+    The cache hits and misses are only counted and the change signal is only emitted while
+    statisticsEnabled is set. As the statistics change with every access to the data of the model, the
+    change signal is emitted at most once per event loop iteration. More details about every
+    fetch, cache miss and eviction are logged using the \c qt.ivi.pagingmodel logging category.
+
+    \sa QIviPagingModelStatistics
+*/
+QIviPagingModelStatistics QIviPagingModel::statistics() const
+{
+    Q_D(const QIviPagingModel);
+    return d->statistics();
 }
 
 /*!
@@ -634,24 +2691,32 @@ QVariant QIviPagingModel::data(const QModelIndex &index, int role) const
         return QVariant();
 
     const int chunkIndex = row / d->m_chunkSize;
-    if (d->m_loadingType == DataChanged && !d->m_availableChunks.at(chunkIndex)) {
-        //qWarning() << "Cache miss: Fetching Data for index " << row << "and following";
+    //The chunk was either never fetched (DataChanged), got evicted from the cache or is outdated
+    if (d->m_chunkCache.isChunkMissing(chunkIndex)) {
+        d->recordCacheAccess(row, role, false);
         const_cast<QIviPagingModelPrivate*>(d)->fetchData(chunkIndex * d->m_chunkSize);
-        return QVariant();
-    }
+        const_cast<QIviPagingModelPrivate*>(d)->onRowAccessed(row);
+        //Outdated rows are still shown, until the fetched chunk replaces them
+        if (!d->m_itemList.at(row).isValid())
+            return QVariant();
+    } else {
+        d->m_chunkCache.touchChunk(chunkIndex);
+        const_cast<QIviPagingModelPrivate*>(d)->onRowAccessed(row);
 
-    if (row >= d->m_fetchedDataCount - d->m_fetchMoreThreshold && canFetchMore(QModelIndex()))
-        emit fetchMoreThresholdReached();
+        if (row >= d->m_fetchedDataCount - d->m_fetchMoreThreshold && canFetchMore(QModelIndex()))
+            emit fetchMoreThresholdReached();
 
-    const QIviStandardItem *item = d->itemAt(row);
-    if (!item) {
-        //qWarning() << "Cache miss: Waiting for fetched Data";
-        return QVariant();
+        if (!d->m_itemList.at(row).isValid()) {
+            d->recordCacheAccess(row, role, false);
+            return QVariant();
+        }
+        if (d->m_statisticsEnabled)
+            d->recordCacheAccess(row, role, true);
     }
 
     switch (role) {
-    case NameRole: return item->name();
-    case TypeRole: return item->type();
+    case NameRole: return d->m_nameColumn.at(row);
+    case TypeRole: return d->m_typeColumn.at(row);
     case ItemRole: return d->m_itemList.at(row);
     }
 
@@ -690,9 +2755,59 @@ QVariant QIviPagingModel::get(int i) const
 void QIviPagingModel::reload()
 {
     Q_D(QIviPagingModel);
+    //Other models using the same query get the fresh data as well
+    if (d->m_sharedCache)
+        d->m_sharedCache->clear();
     d->resetModel();
 }
 
+/*!
+    \qmlmethod PagingModel::setViewport(first, last)
+
+    Informs the model that the rows from \a first to \a last are currently visible.
+
+    All chunks of the visible rows which are not available yet are fetched and the chunks around
+    them are prefetched according to the prefetchDistance property. Once a viewport has been set,
+    the model stops inferring the visible rows from the requested data.
+*/
+/*!
+    Informs the model that the rows from \a first to \a last are currently visible.
+
+    All chunks of the visible rows which are not available yet are fetched and the chunks around
+    them are prefetched according to the prefetchDistance property. Once a viewport has been set,
+    the model stops inferring the visible rows from the requested data.
+*/
+void QIviPagingModel::setViewport(int first, int last)
+{
+    Q_D(QIviPagingModel);
+    if (first < 0 || last < first) {
+        qtivi_qmlOrCppWarning(this, "The provided viewport is invalid. This call will have no effect");
+        return;
+    }
+
+    const int firstChunk = first / d->m_chunkSize;
+    const int lastChunk = last / d->m_chunkSize;
+    int direction = d->m_scrollDirection;
+    bool fastScrolling = false;
+    if (d->m_viewportFirst >= 0) {
+        if (first != d->m_viewportFirst)
+            direction = first > d->m_viewportFirst ? 1 : -1;
+        fastScrolling = qAbs(firstChunk - d->m_viewportFirst / d->m_chunkSize) > 1;
+    }
+
+    d->m_explicitViewport = true;
+    d->m_viewportFirst = first;
+    d->m_viewportLast = last;
+    d->m_scrollDirection = direction;
+    d->onVisibleRowsChanged(first, last);
+
+    for (int i = firstChunk; i <= lastChunk; i++) {
+        d->m_chunkCache.touchChunk(i);
+        d->prefetchChunk(i);
+    }
+    d->prefetchChunks(firstChunk, lastChunk, direction, fastScrolling);
+}
+
 /*!
     \reimp
 */
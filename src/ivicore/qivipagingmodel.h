@@ -46,6 +46,7 @@
 #include <QtIviCore/QIviAbstractFeatureListModel>
 #include <QtIviCore/QtIviCoreModule>
 #include <QtIviCore/QIviServiceObject>
+#include <QtIviCore/QIviPagingModelStatistics>
 
 QT_BEGIN_NAMESPACE
 
@@ -58,6 +59,19 @@ class Q_QTIVICORE_EXPORT QIviPagingModel : public QIviAbstractFeatureListModel
     Q_PROPERTY(QtIviCoreModule::ModelCapabilities capabilities READ capabilities NOTIFY capabilitiesChanged)
     Q_PROPERTY(int chunkSize READ chunkSize WRITE setChunkSize NOTIFY chunkSizeChanged)
     Q_PROPERTY(int fetchMoreThreshold READ fetchMoreThreshold WRITE setFetchMoreThreshold NOTIFY fetchMoreThresholdChanged)
+    Q_PROPERTY(int cacheLimit READ cacheLimit WRITE setCacheLimit NOTIFY cacheLimitChanged)
+    Q_PROPERTY(int prefetchDistance READ prefetchDistance WRITE setPrefetchDistance NOTIFY prefetchDistanceChanged)
+    Q_PROPERTY(bool adaptiveChunkSize READ adaptiveChunkSize WRITE setAdaptiveChunkSize NOTIFY adaptiveChunkSizeChanged)
+    Q_PROPERTY(int minimumChunkSize READ minimumChunkSize WRITE setMinimumChunkSize NOTIFY minimumChunkSizeChanged)
+    Q_PROPERTY(int maximumChunkSize READ maximumChunkSize WRITE setMaximumChunkSize NOTIFY maximumChunkSizeChanged)
+    Q_PROPERTY(qreal fetchLatency READ fetchLatency NOTIFY fetchLatencyChanged)
+    Q_PROPERTY(qreal rowFetchCost READ rowFetchCost NOTIFY rowFetchCostChanged)
+    Q_PROPERTY(int snapshotChunkCount READ snapshotChunkCount WRITE setSnapshotChunkCount NOTIFY snapshotChunkCountChanged)
+    Q_PROPERTY(bool incrementalReload READ incrementalReload WRITE setIncrementalReload NOTIFY incrementalReloadChanged)
+    Q_PROPERTY(bool backgroundDecoding READ backgroundDecoding WRITE setBackgroundDecoding NOTIFY backgroundDecodingChanged)
+    Q_PROPERTY(bool sharedCache READ sharedCache WRITE setSharedCache NOTIFY sharedCacheChanged)
+    Q_PROPERTY(bool statisticsEnabled READ statisticsEnabled WRITE setStatisticsEnabled NOTIFY statisticsEnabledChanged)
+    Q_PROPERTY(QIviPagingModelStatistics statistics READ statistics NOTIFY statisticsChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
 
     //TODO fix naming
@@ -89,6 +103,41 @@ public:
     int fetchMoreThreshold() const;
     void setFetchMoreThreshold(int fetchMoreThreshold);
 
+    int cacheLimit() const;
+    void setCacheLimit(int cacheLimit);
+
+    int prefetchDistance() const;
+    void setPrefetchDistance(int prefetchDistance);
+
+    bool adaptiveChunkSize() const;
+    void setAdaptiveChunkSize(bool adaptiveChunkSize);
+
+    int minimumChunkSize() const;
+    void setMinimumChunkSize(int minimumChunkSize);
+
+    int maximumChunkSize() const;
+    void setMaximumChunkSize(int maximumChunkSize);
+
+    qreal fetchLatency() const;
+    qreal rowFetchCost() const;
+
+    int snapshotChunkCount() const;
+    void setSnapshotChunkCount(int snapshotChunkCount);
+
+    bool incrementalReload() const;
+    void setIncrementalReload(bool incrementalReload);
+
+    bool backgroundDecoding() const;
+    void setBackgroundDecoding(bool backgroundDecoding);
+
+    bool sharedCache() const;
+    void setSharedCache(bool sharedCache);
+
+    bool statisticsEnabled() const;
+    void setStatisticsEnabled(bool statisticsEnabled);
+
+    QIviPagingModelStatistics statistics() const;
+
     QIviPagingModel::LoadingType loadingType() const;
     void setLoadingType(QIviPagingModel::LoadingType loadingType);
 
@@ -102,6 +151,7 @@ public:
 
     Q_INVOKABLE QVariant get(int index) const;
     Q_INVOKABLE void reload();
+    Q_INVOKABLE void setViewport(int first, int last);
 
     template <typename T> T at(int i) const {
         return data(index(i,0), ItemRole).value<T>();
@@ -113,6 +163,19 @@ Q_SIGNALS:
     void countChanged();
     void fetchMoreThresholdChanged(int fetchMoreThreshold);
     void fetchMoreThresholdReached() const;
+    void cacheLimitChanged(int cacheLimit);
+    void prefetchDistanceChanged(int prefetchDistance);
+    void adaptiveChunkSizeChanged(bool adaptiveChunkSize);
+    void minimumChunkSizeChanged(int minimumChunkSize);
+    void maximumChunkSizeChanged(int maximumChunkSize);
+    void fetchLatencyChanged(qreal fetchLatency);
+    void rowFetchCostChanged(qreal rowFetchCost);
+    void snapshotChunkCountChanged(int snapshotChunkCount);
+    void incrementalReloadChanged(bool incrementalReload);
+    void backgroundDecodingChanged(bool backgroundDecoding);
+    void sharedCacheChanged(bool sharedCache);
+    void statisticsEnabledChanged(bool statisticsEnabled);
+    void statisticsChanged();
     void loadingTypeChanged(QIviPagingModel::LoadingType loadingType);
 
 protected:
@@ -57,18 +57,107 @@
 #include <QtIviCore/private/qiviabstractfeaturelistmodel_p.h>
 #include <private/qtiviglobal_p.h>
 
+#include "qivichunkcache_p.h"
 #include "qivipagingmodel.h"
 #include "qivipagingmodelinterface.h"
+#include "qivipagingmodelstatistics.h"
 #include "qivistandarditem.h"
 
 #include <QBitArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QLoggingCategory>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QTimer>
 #include <QUuid>
+#include <QVector>
+
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
+Q_DECLARE_LOGGING_CATEGORY(qLcIviPagingModel)
+
+class QIviPagingModelPrivate;
+class QIviPagingModelDecodeRelay;
+
+class Q_QTIVICORE_EXPORT QIviPagingModelSharedCache
+{
+public:
+    struct Chunk {
+        QList<QVariant> items;
+        bool moreAvailable;
+        //Only used by the QIviSearchAndBrowseModel
+        QVector<bool> canGoForward;
+    };
+
+    static QIviPagingModelSharedCache *acquire(const QString &key, QIviPagingModelPrivate *member);
+    void release(QIviPagingModelPrivate *member);
+
+    QString key() const;
+    QVector<QIviPagingModelPrivate *> members() const;
+    int count() const;
+    void setCount(int count);
+    void setCanGoForward(int start, const QVector<bool> &canGoForward);
+    //Only used by the QIviSearchAndBrowseModel
+    QVariantList sections() const;
+    void setSections(const QVariantList &sections);
+    bool fetch(QIviPagingModelPrivate *member, int start, int count);
+    void chunkFetched(QIviPagingModelPrivate *member, int start, const QList<QVariant> &items, bool moreAvailable);
+    void abandonFetches(QIviPagingModelPrivate *member);
+    void clear();
+
+private:
+    struct SharedFetch {
+        QIviPagingModelPrivate *owner;
+        int count;
+        QVector<QIviPagingModelPrivate *> waiters;
+    };
+
+    explicit QIviPagingModelSharedCache(const QString &key);
+    void evictChunks();
+
+    QString m_key;
+    QVector<QIviPagingModelPrivate *> m_members;
+    QHash<int, Chunk> m_chunks;
+    QVector<int> m_chunkOrder;
+    QHash<int, SharedFetch> m_fetches;
+    int m_count;
+    QVariantList m_sections;
+};
+
 class Q_QTIVICORE_EXPORT QIviPagingModelPrivate : public QIviAbstractFeatureListModelPrivate
 {
 public:
+    struct PendingFetch {
+        int start;
+        int count;
+        int generation;
+        qint64 requestTime;
+    };
+
+    struct FetchSample {
+        int rows;
+        qreal msecs;
+    };
+
+    struct DecodedRow {
+        bool valid;
+        QString id;
+        QString name;
+        QString type;
+    };
+
+    struct IncrementalReload {
+        bool active;
+        int chunkSize;
+        int count;
+        QVector<QList<QVariant>> chunks;
+        QVector<bool> moreAvailable;
+        QBitArray received;
+    };
+
     QIviPagingModelPrivate(const QString &interface, QIviPagingModel *model);
     ~QIviPagingModelPrivate() override;
 
@@ -76,13 +165,61 @@ public:
     void onInitializationDone();
     void onCapabilitiesChanged(const QUuid &identifier, QtIviCoreModule::ModelCapabilities capabilities);
     void onDataFetched(const QUuid &identifier, const QList<QVariant> &items, int start, bool moreAvailable);
+    void processFetchedData(const QUuid &identifier, const QList<QVariant> &items, int start, bool moreAvailable, const QVector<DecodedRow> &decoded);
+    void decodeInBackground(const QList<QVariant> &items, const std::function<void(const QVector<DecodedRow> &)> &handler);
+    static QVector<DecodedRow> decodeRows(const QList<QVariant> &items);
     void onCountChanged(const QUuid &identifier, int new_length);
     void onDataChanged(const QUuid &identifier, const QList<QVariant> &data, int start, int count);
     void onFetchMoreThresholdReached();
     virtual void resetModel();
+    void clearModel();
+    virtual bool handleFetchedData(const QList<QVariant> &items, int start, bool moreAvailable);
+    virtual bool handleCountChanged(int count);
+    virtual bool handleDataChanged();
+    void startIncrementalReload(int lastRow = -1);
+    void checkIncrementalReload();
+    void finishIncrementalReload();
+    void applyReloadedRows(int oldCount, const QList<QVariant> &items);
+    static QVector<bool> stableRows(const QVector<int> &targets);
     virtual void clearToDefaults();
     const QIviStandardItem *itemAt(int i) const;
+    void setRow(int row, const QVariant &item);
+    void setDecodedRow(int row, const QVariant &item, const DecodedRow &decoded);
+    void clearRow(int row);
+    void insertRows(int row, const QList<QVariant> &items, const QVector<DecodedRow> &decoded = QVector<DecodedRow>());
+    void insertEmptyRows(int row, int count);
+    void removeRows(int row, int count);
+    void moveRow(int from, int to);
+    void clearRows();
+    void replaceRows(int start, const QList<QVariant> &items, const QVector<DecodedRow> &decoded = QVector<DecodedRow>(), bool reconcile = false);
+    bool isSameRow(int row, const QVariant &item) const;
+    virtual QString cacheKey() const;
+    static QString snapshotFilePath(const QString &key);
+    void scheduleSnapshot();
+    void flushSnapshot();
+    void writeSnapshot();
+    int restoreSnapshot();
     void fetchData(int startIndex);
+    bool isFetchPending(int start) const;
+    int pendingFetchCount() const;
+    bool takePendingFetch(int start, qint64 *requestTime = nullptr);
+    void cancelPendingFetches();
+    void cancelPendingFetch(int start);
+    void addFetchSample(int rows, qint64 elapsed);
+    void recordFetch(int start, int rows, qint64 elapsed);
+    void recordCacheAccess(int row, int role, bool hit) const;
+    void scheduleStatisticsUpdate() const;
+    QIviPagingModelStatistics statistics() const;
+    bool fitFetchSamples(qreal *latency, qreal *rowCost) const;
+    void adaptChunkSize();
+    void evictChunk(int chunkIndex, int start, int end);
+    void onRowAccessed(int row);
+    virtual void onVisibleRowsChanged(int first, int last);
+    void prefetchChunks(int firstChunk, int lastChunk, int direction, bool fastScrolling);
+    void prefetchChunk(int chunkIndex);
+    QString sharedCacheKey() const;
+    void updateSharedCache();
+    virtual void deliverSharedChunk(int start, const QIviPagingModelSharedCache::Chunk &chunk);
 
     QIviPagingModelInterface *backend() const;
 
@@ -92,10 +229,63 @@ public:
     QtIviCoreModule::ModelCapabilities m_capabilities;
     int m_chunkSize;
 
-    QList<QVariant> m_itemList;
-    QBitArray m_availableChunks;
+    //The items are stored column-wise, the id, name and type columns are extracted once the data arrives
+    QVector<QVariant> m_itemList;
+    QVector<QString> m_idColumn;
+    QVector<QString> m_nameColumn;
+    QVector<QString> m_typeColumn;
+    QIviChunkCache m_chunkCache;
     bool m_moreAvailable;
 
+    int m_prefetchDistance;
+    bool m_explicitViewport;
+    int m_viewportFirst;
+    int m_viewportLast;
+    int m_lastAccessedRow;
+    int m_scrollDirection;
+    mutable quint64 m_cacheHits;
+    mutable quint64 m_cacheMisses;
+    mutable QHash<int, quint64> m_roleCacheHits;
+    mutable QHash<int, quint64> m_roleCacheMisses;
+    quint64 m_fetchCount;
+    qreal m_totalFetchLatency;
+    QVector<int> m_fetchLatencyHistogram;
+    quint64 m_evictedChunkCount;
+    bool m_statisticsEnabled;
+    mutable bool m_statisticsUpdatePending;
+
+    QVector<PendingFetch> m_pendingFetches;
+    int m_fetchGeneration;
+
+    bool m_adaptiveChunkSize;
+    int m_minimumChunkSize;
+    int m_maximumChunkSize;
+    qreal m_fetchLatency;
+    qreal m_rowFetchCost;
+    QVector<FetchSample> m_fetchSamples;
+    QElapsedTimer m_fetchTimer;
+
+    int m_snapshotChunkCount;
+    QTimer m_snapshotTimer;
+    QString m_snapshotKey;
+    //The rows restored from a snapshot, which are compared with the data of the backend once fetched again
+    QBitArray m_restoredRows;
+
+    bool m_incrementalReload;
+    IncrementalReload m_reload;
+    QIviPagingModel::LoadingType m_rowsLoadingType;
+
+    bool m_sharedCacheEnabled;
+    QIviPagingModelSharedCache *m_sharedCache;
+
+    bool m_backgroundDecoding;
+    QSharedPointer<QIviPagingModelDecodeRelay> m_decodeRelay;
+    int m_pendingDecodes;
+    bool m_replayingDecoded;
+    quint64 m_decodedChunkCount;
+    qint64 m_decodeTime;
+    qint64 m_decodeHandOffTime;
+
     QUuid m_identifier;
     int m_fetchMoreThreshold;
     int m_fetchedDataCount;
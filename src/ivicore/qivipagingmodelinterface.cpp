@@ -114,6 +114,28 @@ QIviPagingModelInterface::QIviPagingModelInterface(QObjectPrivate &dd, QObject *
     \sa dataFetched()
 */
 
+/*!
+    This function is called by the QIviPagingModel identified by \a identifier when the result of a
+    previous fetchData() call for the range defined by \a start and \a count is no longer needed,
+    e.g. because the model has been reset in the meantime.
+
+    Backends can use this to abort expensive work, like a running database query or an IPC call.
+    Return \c true if the request has been aborted and the dataFetched() signal will \b not be
+    emitted for it. Return \c false if the result will still be delivered; the model will then
+    discard it once it arrives.
+
+    The default implementation doesn't abort anything and returns \c false.
+
+    \sa fetchData()
+*/
+bool QIviPagingModelInterface::cancelFetch(const QUuid &identifier, int start, int count)
+{
+    Q_UNUSED(identifier)
+    Q_UNUSED(start)
+    Q_UNUSED(count)
+    return false;
+}
+
 /*!
     \fn void QIviPagingModelInterface::supportedCapabilitiesChanged(const QUuid &identifier, QtIviCoreModule::ModelCapabilities capabilities)
 
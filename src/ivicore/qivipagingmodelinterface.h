@@ -63,6 +63,7 @@ public:
     virtual void unregisterInstance(const QUuid &identifier) = 0;
 
     virtual void fetchData(const QUuid &identifier, int start, int count) = 0;
+    virtual bool cancelFetch(const QUuid &identifier, int start, int count);
 
 protected:
     QIviPagingModelInterface(QObjectPrivate &dd, QObject *parent = nullptr);
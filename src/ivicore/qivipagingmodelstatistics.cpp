@@ -0,0 +1,360 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#include "qivipagingmodelstatistics.h"
+#include "qivipagingmodelstatistics_p.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace qtivi_helper {
+    //The upper limits of the fetch latency histogram buckets, in milliseconds
+    static const qreal latencyBucketLimits[] = { 1, 2, 5, 10, 20, 50, 100, 200, 500, 1000 };
+    static const int latencyBucketCount = sizeof(latencyBucketLimits) / sizeof(latencyBucketLimits[0]);
+}
+
+using namespace qtivi_helper;
+
+QVector<qreal> QIviPagingModelStatisticsPrivate::latencyBuckets()
+{
+    return QVector<qreal>(latencyBucketLimits, latencyBucketLimits + latencyBucketCount);
+}
+
+int QIviPagingModelStatisticsPrivate::latencyBucket(qreal msecs)
+{
+    //Everything above the highest limit ends up in an additional last bucket
+    for (int i = 0; i < latencyBucketCount; i++) {
+        if (msecs <= latencyBucketLimits[i])
+            return i;
+    }
+    return latencyBucketCount;
+}
+
+/*!
+    \class QIviPagingModelStatistics
+    \inmodule QtIviCore
+    \brief The QIviPagingModelStatistics holds the cache and fetch statistics of a QIviPagingModel.
+
+    The statistics are a snapshot taken when QIviPagingModel::statistics is read. The counters
+    are reset together with the model, e.g. when the backend changes.
+
+    More detailed information about every fetch, cache miss and eviction is available by enabling
+    the \c qt.ivi.pagingmodel logging category.
+*/
+
+/*!
+    \qmltype PagingModelStatistics
+    \qmlabstract
+    \instantiates QIviPagingModelStatistics
+    \inqmlmodule QtIvi
+    \brief The PagingModelStatistics holds the cache and fetch statistics of a PagingModel.
+
+    The statistics are a snapshot taken when PagingModel::statistics is read. The counters are
+    reset together with the model, e.g. when the backend changes.
+
+    \note This item is not creatable from QML.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::cacheHits
+    The number of data requests which were answered from the rows held in memory.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::cacheHits
+    The number of data requests which were answered from the rows held in memory.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::cacheMisses
+    The number of data requests for rows which were not fetched yet, got evicted or are still
+    on their way.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::cacheMisses
+    The number of data requests for rows which were not fetched yet, got evicted or are still
+    on their way.
+*/
+
+/*!
+    \qmlproperty object PagingModelStatistics::roleCacheHits
+    The cacheHits split by the name of the requested role.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::roleCacheHits
+    The cacheHits split by the name of the requested role.
+*/
+
+/*!
+    \qmlproperty object PagingModelStatistics::roleCacheMisses
+    The cacheMisses split by the name of the requested role.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::roleCacheMisses
+    The cacheMisses split by the name of the requested role.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::pendingFetches
+    The number of chunks which were requested, but didn't arrive yet.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::pendingFetches
+    The number of chunks which were requested, but didn't arrive yet.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::fetchCount
+    The number of fetched chunks, which were used to calculate the fetch latency.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::fetchCount
+    The number of fetched chunks, which were used to calculate the fetch latency.
+*/
+
+/*!
+    \qmlproperty real PagingModelStatistics::averageFetchLatency
+    The average time in milliseconds between requesting a chunk and receiving it.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::averageFetchLatency
+    The average time in milliseconds between requesting a chunk and receiving it.
+*/
+
+/*!
+    \qmlproperty list<real> PagingModelStatistics::fetchLatencyBuckets
+    The upper limits in milliseconds of the buckets of the fetchLatencyHistogram.
+
+    The histogram has one additional bucket for all fetches which took longer than the last limit.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::fetchLatencyBuckets
+    The upper limits in milliseconds of the buckets of the fetchLatencyHistogram.
+
+    The histogram has one additional bucket for all fetches which took longer than the last limit.
+*/
+
+/*!
+    \qmlproperty list<int> PagingModelStatistics::fetchLatencyHistogram
+    The number of fetches per latency bucket, see fetchLatencyBuckets.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::fetchLatencyHistogram
+    The number of fetches per latency bucket, see fetchLatencyBuckets.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::rowCount
+    The number of rows of the model.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::rowCount
+    The number of rows of the model.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::cachedRowCount
+    The number of rows which are held in memory.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::cachedRowCount
+    The number of rows which are held in memory.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::cachedChunkCount
+    The number of chunks which are held in memory.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::cachedChunkCount
+    The number of chunks which are held in memory.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::evictedChunkCount
+    The number of chunks which got evicted from the cache to stay within the cacheLimit.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::evictedChunkCount
+    The number of chunks which got evicted from the cache to stay within the cacheLimit.
+*/
+
+/*!
+    \qmlproperty int PagingModelStatistics::decodedChunkCount
+    The number of chunks which were decoded on a worker thread, see PagingModel::backgroundDecoding.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::decodedChunkCount
+    The number of chunks which were decoded on a worker thread, see QIviPagingModel::backgroundDecoding.
+*/
+
+/*!
+    \qmlproperty real PagingModelStatistics::decodeTime
+    The time in milliseconds spent on the worker thread decoding the chunks.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::decodeTime
+    The time in milliseconds spent on the worker thread decoding the chunks.
+*/
+
+/*!
+    \qmlproperty real PagingModelStatistics::decodeHandOffTime
+    The time in milliseconds spent on the thread of the model inserting the decoded chunks.
+*/
+
+/*!
+    \property QIviPagingModelStatistics::decodeHandOffTime
+    The time in milliseconds spent on the thread of the model inserting the decoded chunks.
+*/
+
+QIviPagingModelStatistics::QIviPagingModelStatistics()
+    : d(new QIviPagingModelStatisticsPrivate)
+{
+    d->m_fetchLatencyHistogram.fill(0, latencyBucketCount + 1);
+}
+
+//defined here as a inline default copy constructor leads to compilation errors
+QIviPagingModelStatistics::QIviPagingModelStatistics(const QIviPagingModelStatistics &rhs) = default;
+
+QIviPagingModelStatistics &QIviPagingModelStatistics::operator=(const QIviPagingModelStatistics &rhs)
+{
+    if (this != &rhs)
+        d.operator=(rhs.d);
+    return *this;
+}
+
+//defined here as a inline default destructor leads to compilation errors
+QIviPagingModelStatistics::~QIviPagingModelStatistics() = default;
+
+quint64 QIviPagingModelStatistics::cacheHits() const
+{
+    return d->m_cacheHits;
+}
+
+quint64 QIviPagingModelStatistics::cacheMisses() const
+{
+    return d->m_cacheMisses;
+}
+
+QVariantMap QIviPagingModelStatistics::roleCacheHits() const
+{
+    return d->m_roleCacheHits;
+}
+
+QVariantMap QIviPagingModelStatistics::roleCacheMisses() const
+{
+    return d->m_roleCacheMisses;
+}
+
+int QIviPagingModelStatistics::pendingFetches() const
+{
+    return d->m_pendingFetches;
+}
+
+quint64 QIviPagingModelStatistics::fetchCount() const
+{
+    return d->m_fetchCount;
+}
+
+qreal QIviPagingModelStatistics::averageFetchLatency() const
+{
+    return d->m_averageFetchLatency;
+}
+
+QList<qreal> QIviPagingModelStatistics::fetchLatencyBuckets() const
+{
+    return QIviPagingModelStatisticsPrivate::latencyBuckets().toList();
+}
+
+QList<int> QIviPagingModelStatistics::fetchLatencyHistogram() const
+{
+    return d->m_fetchLatencyHistogram.toList();
+}
+
+int QIviPagingModelStatistics::rowCount() const
+{
+    return d->m_rowCount;
+}
+
+int QIviPagingModelStatistics::cachedRowCount() const
+{
+    return d->m_cachedRowCount;
+}
+
+int QIviPagingModelStatistics::cachedChunkCount() const
+{
+    return d->m_cachedChunkCount;
+}
+
+quint64 QIviPagingModelStatistics::evictedChunkCount() const
+{
+    return d->m_evictedChunkCount;
+}
+
+quint64 QIviPagingModelStatistics::decodedChunkCount() const
+{
+    return d->m_decodedChunkCount;
+}
+
+qreal QIviPagingModelStatistics::decodeTime() const
+{
+    return d->m_decodeTime;
+}
+
+qreal QIviPagingModelStatistics::decodeHandOffTime() const
+{
+    return d->m_decodeHandOffTime;
+}
+
+QT_END_NAMESPACE
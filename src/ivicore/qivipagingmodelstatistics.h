@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#ifndef QIVIPAGINGMODELSTATISTICS_H
+#define QIVIPAGINGMODELSTATISTICS_H
+
+#include <QtCore/QMetaType>
+#include <QtCore/QSharedDataPointer>
+#include <QtCore/QVariantMap>
+#include <QtCore/qobjectdefs.h>
+#include <QtIviCore/qtiviglobal.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIviPagingModelStatisticsPrivate;
+
+class Q_QTIVICORE_EXPORT QIviPagingModelStatistics
+{
+    Q_GADGET
+
+    Q_PROPERTY(quint64 cacheHits READ cacheHits)
+    Q_PROPERTY(quint64 cacheMisses READ cacheMisses)
+    Q_PROPERTY(QVariantMap roleCacheHits READ roleCacheHits)
+    Q_PROPERTY(QVariantMap roleCacheMisses READ roleCacheMisses)
+    Q_PROPERTY(int pendingFetches READ pendingFetches)
+    Q_PROPERTY(quint64 fetchCount READ fetchCount)
+    Q_PROPERTY(qreal averageFetchLatency READ averageFetchLatency)
+    Q_PROPERTY(QList<qreal> fetchLatencyBuckets READ fetchLatencyBuckets)
+    Q_PROPERTY(QList<int> fetchLatencyHistogram READ fetchLatencyHistogram)
+    Q_PROPERTY(int rowCount READ rowCount)
+    Q_PROPERTY(int cachedRowCount READ cachedRowCount)
+    Q_PROPERTY(int cachedChunkCount READ cachedChunkCount)
+    Q_PROPERTY(quint64 evictedChunkCount READ evictedChunkCount)
+    Q_PROPERTY(quint64 decodedChunkCount READ decodedChunkCount)
+    Q_PROPERTY(qreal decodeTime READ decodeTime)
+    Q_PROPERTY(qreal decodeHandOffTime READ decodeHandOffTime)
+
+public:
+    QIviPagingModelStatistics();
+    QIviPagingModelStatistics(const QIviPagingModelStatistics &);
+    QIviPagingModelStatistics &operator=(const QIviPagingModelStatistics &);
+    ~QIviPagingModelStatistics();
+
+    quint64 cacheHits() const;
+    quint64 cacheMisses() const;
+    QVariantMap roleCacheHits() const;
+    QVariantMap roleCacheMisses() const;
+    int pendingFetches() const;
+    quint64 fetchCount() const;
+    qreal averageFetchLatency() const;
+    QList<qreal> fetchLatencyBuckets() const;
+    QList<int> fetchLatencyHistogram() const;
+    int rowCount() const;
+    int cachedRowCount() const;
+    int cachedChunkCount() const;
+    quint64 evictedChunkCount() const;
+    quint64 decodedChunkCount() const;
+    qreal decodeTime() const;
+    qreal decodeHandOffTime() const;
+
+private:
+    QSharedDataPointer<QIviPagingModelStatisticsPrivate> d;
+    friend class QIviPagingModelPrivate;
+};
+
+Q_DECLARE_TYPEINFO(QIviPagingModelStatistics, Q_MOVABLE_TYPE);
+
+QT_END_NAMESPACE
+
+Q_DECLARE_METATYPE(QIviPagingModelStatistics)
+
+#endif // QIVIPAGINGMODELSTATISTICS_H
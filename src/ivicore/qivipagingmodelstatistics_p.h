@@ -0,0 +1,93 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#ifndef QIVIPAGINGMODELSTATISTICS_P_H
+#define QIVIPAGINGMODELSTATISTICS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtiviglobal_p.h>
+
+#include "qivipagingmodelstatistics.h"
+
+#include <QHash>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+
+class QIviPagingModelStatisticsPrivate : public QSharedData
+{
+public:
+    QIviPagingModelStatisticsPrivate() = default;
+    QIviPagingModelStatisticsPrivate(const QIviPagingModelStatisticsPrivate &other) = default;
+
+    static QVector<qreal> latencyBuckets();
+    static int latencyBucket(qreal msecs);
+
+    quint64 m_cacheHits = 0;
+    quint64 m_cacheMisses = 0;
+    QVariantMap m_roleCacheHits;
+    QVariantMap m_roleCacheMisses;
+    int m_pendingFetches = 0;
+    quint64 m_fetchCount = 0;
+    qreal m_averageFetchLatency = 0;
+    QVector<int> m_fetchLatencyHistogram;
+    int m_rowCount = 0;
+    int m_cachedRowCount = 0;
+    int m_cachedChunkCount = 0;
+    quint64 m_evictedChunkCount = 0;
+    quint64 m_decodedChunkCount = 0;
+    qreal m_decodeTime = 0;
+    qreal m_decodeHandOffTime = 0;
+};
+
+QT_END_NAMESPACE
+
+#endif // QIVIPAGINGMODELSTATISTICS_P_H
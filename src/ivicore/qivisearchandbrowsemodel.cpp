@@ -47,22 +47,63 @@
 #include "qivisearchandbrowsemodelinterface.h"
 #include "queryparser/qiviqueryparser_p.h"
 
+#include <QCache>
 #include <QDebug>
 #include <QMetaObject>
+#include <QMutex>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
+namespace qtivi_helper {
+    //The number of parsed queries kept by all models of the process
+    static const int parsedQueryCacheSize = 32;
+
+    //The number of levels kept by every model to be shown again when going back
+    static const int navigationHistorySize = 8;
+
+    //The number of visible rows the next level is fetched for in the background
+    static const int childPrefetchLimit = 4;
+
+    //The time in milliseconds the visible rows need to stay the same before their children are fetched
+    static const int childPrefetchDelay = 100;
+
+    //The parsed queries, indexed by the query and the identifiers allowed in it
+    struct ParsedQueryCache {
+        QMutex mutex;
+        QCache<QString, QIviSearchAndBrowseModelPrivate::ParsedQuery> cache{parsedQueryCacheSize};
+    };
+    Q_GLOBAL_STATIC(ParsedQueryCache, parsedQueries)
+}
+
+using namespace qtivi_helper;
+
 QIviSearchAndBrowseModelPrivate::QIviSearchAndBrowseModelPrivate(const QString &interface, QIviSearchAndBrowseModel *model)
     : QIviPagingModelPrivate(interface, model)
     , q_ptr(model)
-    , m_queryTerm(nullptr)
+    , m_queryDelay(0)
+    , m_localQuery(false)
+    , m_local{false, false, 0, -1, {}, {}, {}, {}}
     , m_canGoBack(false)
+    , m_restoreNavigationLevel(false)
+    , m_prefetchChildren(false)
+    , m_childPrefetchFirst(-1)
+    , m_childPrefetchLast(-1)
+    , m_childPrefetchDeferred(false)
 {
+    m_queryTimer.setSingleShot(true);
+    QObject::connect(&m_queryTimer, &QTimer::timeout, [this]() {
+        applyQuery();
+    });
+    m_childPrefetchTimer.setSingleShot(true);
+    QObject::connect(&m_childPrefetchTimer, &QTimer::timeout, [this]() {
+        updateChildPrefetches();
+    });
 }
 
 QIviSearchAndBrowseModelPrivate::~QIviSearchAndBrowseModelPrivate()
 {
-    delete m_queryTerm;
 }
 
 void QIviSearchAndBrowseModelPrivate::resetModel()
@@ -73,49 +114,299 @@ void QIviSearchAndBrowseModelPrivate::resetModel()
         backend->setContentType(m_identifier, m_contentTypeRequested);
 }
 
+QString QIviSearchAndBrowseModelPrivate::cacheKey() const
+{
+    //The rows of a local query don't match the chunks of the backend
+    if (m_local.active)
+        return QString();
+
+    const QString key = QIviPagingModelPrivate::cacheKey();
+    if (key.isEmpty())
+        return key;
+
+    return key + QLatin1Char('/') + m_contentType + QLatin1Char('/') + m_query;
+}
+
 void QIviSearchAndBrowseModelPrivate::parseQuery()
 {
+    //A delayed query is applied now as well
+    m_queryTimer.stop();
+    m_local.active = false;
+    m_local.term.reset();
+    m_local.orderTerms.clear();
+
     if (!searchBackend())
         return;
 
     if (m_query.isEmpty()) {
         //The new query is empty, tell it to the backend and delete the old term
-        setupFilter(nullptr, {});
+        setupFilter(QSharedPointer<QIviAbstractQueryTerm>(), {});
+        m_appliedQuery = m_query;
         return;
     }
 
-    if (!m_capabilities.testFlag(QtIviCoreModule::SupportsFiltering) && !m_capabilities.testFlag(QtIviCoreModule::SupportsSorting)) {
+    //Whatever the backend doesn't support is done by the model, if requested
+    const bool localFilter = m_localQuery && !m_capabilities.testFlag(QtIviCoreModule::SupportsFiltering);
+    const bool localSort = m_localQuery && !m_capabilities.testFlag(QtIviCoreModule::SupportsSorting);
+
+    if (!m_localQuery && !m_capabilities.testFlag(QtIviCoreModule::SupportsFiltering) && !m_capabilities.testFlag(QtIviCoreModule::SupportsSorting)) {
         qtivi_qmlOrCppWarning(q_ptr, QStringLiteral("The backend doesn't support filtering or sorting. Changing the query will have no effect"));
         return;
     }
 
-    QIviQueryParser parser;
-    parser.setQuery(m_query);
-    parser.setAllowedIdentifiers(m_queryIdentifiers);
+    const ParsedQuery parsed = parsedQuery(m_query, m_queryIdentifiers);
+
+    if (!parsed.term) {
+        qtivi_qmlOrCppWarning(q_ptr, parsed.error);
+        return;
+    }
+
+    m_local.active = localFilter || localSort;
+    if (localFilter)
+        m_local.term = parsed.term;
+    if (localSort)
+        m_local.orderTerms = parsed.orderTerms;
+
+    setupFilter(localFilter ? QSharedPointer<QIviAbstractQueryTerm>() : parsed.term,
+                localSort ? QList<QIviOrderTerm>() : parsed.orderTerms);
+    m_appliedQuery = m_query;
+}
 
-    QIviAbstractQueryTerm* queryTerm = parser.parse();
+void QIviSearchAndBrowseModelPrivate::applyQuery()
+{
+    m_queryTimer.stop();
 
-    if (!queryTerm) {
-        qtivi_qmlOrCppWarning(q_ptr, parser.lastError());
+    if (refineQuery())
         return;
+
+    //The query is checked in resetModel
+    resetModel();
+}
+
+bool QIviSearchAndBrowseModelPrivate::refineQuery()
+{
+    //The refinement is part of the search-as-you-type mode
+    if (m_queryDelay <= 0 || !searchBackend() || m_query.isEmpty())
+        return false;
+    if (!m_localQuery && !m_capabilities.testFlag(QtIviCoreModule::SupportsFiltering))
+        return false;
+
+    //The rows can only be refined if all of them are known
+    if (m_contentType != m_contentTypeRequested || m_reload.active || pendingFetchCount() || m_moreAvailable)
+        return false;
+    if (m_local.active && !m_local.complete)
+        return false;
+    for (const QVariant &item : qAsConst(m_itemList)) {
+        if (!item.isValid())
+            return false;
+    }
+
+    const ParsedQuery parsed = parsedQuery(m_query, m_queryIdentifiers);
+    const ParsedQuery previous = m_appliedQuery.isEmpty() ? ParsedQuery() : parsedQuery(m_appliedQuery, m_queryIdentifiers);
+    if (!parsed.term || (!m_appliedQuery.isEmpty() && !previous.term))
+        return false;
+
+    //The order of the rows stays the same, only the rows which don't match anymore are removed
+    if (parsed.orderTerms.count() != previous.orderTerms.count())
+        return false;
+    for (int i = 0; i < parsed.orderTerms.count(); i++) {
+        if (parsed.orderTerms.at(i).propertyName() != previous.orderTerms.at(i).propertyName()
+                || parsed.orderTerms.at(i).isAscending() != previous.orderTerms.at(i).isAscending())
+            return false;
+    }
+
+    if (!narrowsQuery(parsed.term.data(), previous.term.data()))
+        return false;
+
+    //The rows of types which can't be evaluated are left to the backend
+    QHash<int, QIviQueryTermEvaluator> evaluators;
+    QBitArray matches(m_itemList.count());
+    for (int i = 0; i < m_itemList.count(); i++) {
+        const QVariant &item = m_itemList.at(i);
+        const int type = item.userType();
+        auto it = evaluators.constFind(type);
+        if (it == evaluators.constEnd()) {
+            const QMetaObject *metaObject = QMetaType::typeFlags(type).testFlag(QMetaType::IsGadget) ? QMetaType::metaObjectForType(type) : nullptr;
+            it = evaluators.insert(type, QIviQueryTermEvaluator(metaObject, parsed.term.data(), m_local.orderTerms));
+            if (!it->isValid())
+                return false;
+        }
+        matches.setBit(i, it->matches(item));
     }
-    QList<QIviOrderTerm> orderTerms = parser.orderTerms();
 
-    setupFilter(queryTerm, orderTerms);
+    //The backend keeps the previous filter and the rows are mapped to its positions like for a
+    //local query. A reset of the model applies the new query to the backend.
+    if (!m_local.active) {
+        updateSections(QVariantList());
+        m_local.active = true;
+        m_local.complete = true;
+        m_local.fetchedCount = m_itemList.count();
+        m_local.count = m_itemList.count();
+        m_local.sourceRows.resize(m_itemList.count());
+        for (int i = 0; i < m_itemList.count(); i++)
+            m_local.sourceRows[i] = i;
+    }
+    m_local.term = parsed.term;
+    m_local.evaluators = evaluators;
+    m_appliedQuery = m_query;
+    updateSharedCache();
+
+    Q_Q(QIviSearchAndBrowseModel);
+    for (int end = m_itemList.count(); end > 0;) {
+        if (matches.testBit(end - 1)) {
+            end--;
+            continue;
+        }
+
+        int start = end - 1;
+        while (start > 0 && !matches.testBit(start - 1))
+            start--;
+
+        q->beginRemoveRows(QModelIndex(), start, end - 1);
+        removeRows(start, end - start);
+        m_local.sourceRows.remove(start, end - start);
+        q->endRemoveRows();
+        end = start;
+    }
+
+    return true;
+}
+
+bool QIviSearchAndBrowseModelPrivate::narrowsQuery(const QIviAbstractQueryTerm *term, const QIviAbstractQueryTerm *previous)
+{
+    //Returns whether all rows matching the term also match the previous term. Terms which can't be
+    //compared easily are not considered to be narrower.
+    if (!previous)
+        return true;
+    if (!term)
+        return false;
+    if (term->toString() == previous->toString())
+        return true;
+
+    if (term->type() == QIviAbstractQueryTerm::ScopeTerm) {
+        auto scope = static_cast<const QIviScopeTerm *>(term);
+        if (!scope->isNegated() && narrowsQuery(scope->term(), previous))
+            return true;
+    } else if (term->type() == QIviAbstractQueryTerm::ConjunctionTerm) {
+        auto conjunction = static_cast<const QIviConjunctionTerm *>(term);
+        const auto terms = conjunction->terms();
+        if (conjunction->conjunction() == QIviConjunctionTerm::And) {
+            for (const QIviAbstractQueryTerm *child : terms) {
+                if (narrowsQuery(child, previous))
+                    return true;
+            }
+        } else {
+            bool all = true;
+            for (const QIviAbstractQueryTerm *child : terms)
+                all = all && narrowsQuery(child, previous);
+            if (all)
+                return true;
+        }
+    }
+
+    if (previous->type() == QIviAbstractQueryTerm::ScopeTerm) {
+        auto scope = static_cast<const QIviScopeTerm *>(previous);
+        return !scope->isNegated() && narrowsQuery(term, scope->term());
+    } else if (previous->type() == QIviAbstractQueryTerm::ConjunctionTerm) {
+        auto conjunction = static_cast<const QIviConjunctionTerm *>(previous);
+        const auto terms = conjunction->terms();
+        const bool isAnd = conjunction->conjunction() == QIviConjunctionTerm::And;
+        for (const QIviAbstractQueryTerm *child : terms) {
+            if (narrowsQuery(term, child) != isAnd)
+                return !isAnd;
+        }
+        return isAnd;
+    }
+
+    if (term->type() != QIviAbstractQueryTerm::FilterTerm || previous->type() != QIviAbstractQueryTerm::FilterTerm)
+        return false;
+
+    auto filter = static_cast<const QIviFilterTerm *>(term);
+    auto previousFilter = static_cast<const QIviFilterTerm *>(previous);
+    if (filter->propertyName() != previousFilter->propertyName() || filter->isNegated() || previousFilter->isNegated())
+        return false;
+
+    const QVariant value = filter->value();
+    const QVariant previousValue = previousFilter->value();
+    const QIviFilterTerm::Operator op = filter->operatorType();
+    const QIviFilterTerm::Operator previousOp = previousFilter->operatorType();
+
+    //A longer prefix or substring of a wildcard pattern, e.g. while typing a name
+    if (previousOp == QIviFilterTerm::EqualsCaseInsensitive && previousValue.type() == QVariant::String
+            && (op == QIviFilterTerm::EqualsCaseInsensitive || op == QIviFilterTerm::Equals) && value.type() == QVariant::String) {
+        const QString pattern = previousValue.toString();
+        const QStringList parts = value.toString().split(QLatin1Char('*'));
+        if (pattern.count(QLatin1Char('*')) == 1 && pattern.endsWith(QLatin1Char('*')))
+            return parts.first().startsWith(pattern.chopped(1), Qt::CaseInsensitive);
+        if (pattern.count(QLatin1Char('*')) == 2 && pattern.startsWith(QLatin1Char('*')) && pattern.endsWith(QLatin1Char('*'))) {
+            const QString part = pattern.mid(1, pattern.length() - 2);
+            for (const QString &valuePart : parts) {
+                if (valuePart.contains(part, Qt::CaseInsensitive))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    //A higher lower bound or a lower upper bound
+    bool numeric = false;
+    const double number = value.toDouble(&numeric);
+    bool previousNumeric = false;
+    const double previousNumber = previousValue.toDouble(&previousNumeric);
+    if (!numeric || !previousNumeric || value.type() == QVariant::String || previousValue.type() == QVariant::String)
+        return false;
+
+    const bool exclusive = op == QIviFilterTerm::GreaterThan || op == QIviFilterTerm::LowerThan
+            || previousOp == QIviFilterTerm::GreaterEquals || previousOp == QIviFilterTerm::LowerEquals;
+    if ((op == QIviFilterTerm::GreaterThan || op == QIviFilterTerm::GreaterEquals)
+            && (previousOp == QIviFilterTerm::GreaterThan || previousOp == QIviFilterTerm::GreaterEquals))
+        return number > previousNumber || (number == previousNumber && exclusive);
+    if ((op == QIviFilterTerm::LowerThan || op == QIviFilterTerm::LowerEquals)
+            && (previousOp == QIviFilterTerm::LowerThan || previousOp == QIviFilterTerm::LowerEquals))
+        return number < previousNumber || (number == previousNumber && exclusive);
+
+    return false;
 }
 
-void QIviSearchAndBrowseModelPrivate::setupFilter(QIviAbstractQueryTerm* queryTerm, const QList<QIviOrderTerm> &orderTerms)
+QIviSearchAndBrowseModelPrivate::ParsedQuery QIviSearchAndBrowseModelPrivate::parsedQuery(const QString &query, const QSet<QString> &identifiers)
+{
+    //The identifiers change with the content type and result in a different term or error
+    QStringList sortedIdentifiers = identifiers.values();
+    std::sort(sortedIdentifiers.begin(), sortedIdentifiers.end());
+    const QString key = sortedIdentifiers.join(QLatin1Char(',')) + QLatin1Char('\n') + query;
+
+    ParsedQueryCache *cache = parsedQueries();
+    {
+        QMutexLocker locker(&cache->mutex);
+        if (const ParsedQuery *parsed = cache->cache.object(key))
+            return *parsed;
+    }
+
+    QIviQueryParser parser;
+    parser.setAllowedIdentifiers(identifiers);
+
+    ParsedQuery *parsed = new ParsedQuery;
+    parsed->term = parser.parse(QStringView(query));
+    if (parsed->term)
+        parsed->orderTerms = parser.orderTerms();
+    else
+        parsed->error = parser.lastError();
+
+    const ParsedQuery result = *parsed;
+    QMutexLocker locker(&cache->mutex);
+    cache->cache.insert(key, parsed);
+    return result;
+}
+
+void QIviSearchAndBrowseModelPrivate::setupFilter(const QSharedPointer<QIviAbstractQueryTerm> &queryTerm, const QList<QIviOrderTerm> &orderTerms)
 {
     //1. Tell the backend about the new filter (or none)
     QIviSearchAndBrowseModelInterface* backend = searchBackend();
     if (backend)
-        backend->setupFilter(m_identifier, queryTerm, orderTerms);
+        backend->setupFilter(m_identifier, queryTerm.data(), orderTerms);
 
-    //2. Now it's safe to delete the old filter
-    delete m_queryTerm;
-    m_queryTerm = nullptr;
-
-    //3. Save the new filter
+    //2. Save the new filter. This releases the old one, which is deleted once it isn't cached
+    //anymore and no other model uses it.
     m_queryTerm = queryTerm;
     m_orderTerms = orderTerms;
 }
@@ -125,30 +416,238 @@ void QIviSearchAndBrowseModelPrivate::clearToDefaults()
     QIviPagingModelPrivate::clearToDefaults();
 
     Q_Q(QIviSearchAndBrowseModel);
-    delete m_queryTerm;
-    m_queryTerm = nullptr;
+    m_queryTerm.reset();
     m_query.clear();
     emit q->queryChanged(m_query);
+    m_appliedQuery.clear();
+    m_queryTimer.stop();
+    m_queryDelay = 0;
+    emit q->queryDelayChanged(m_queryDelay);
+    m_localQuery = false;
+    emit q->localQueryChanged(m_localQuery);
+    m_local.active = false;
     m_contentType = QString();
     emit q->contentTypeChanged(m_contentType);
     m_contentTypeRequested = QString();
     m_canGoBack = false;
     emit q->canGoBackChanged(m_canGoBack);
+    m_sections.clear();
+    emit q->sectionsChanged(m_sections);
     m_availableContentTypes.clear();
     emit q->availableContentTypesChanged(m_availableContentTypes);
     m_canGoForward.clear();
+    m_navigationHistory.clear();
+    m_restoreNavigationLevel = false;
+    m_prefetchChildren = false;
+    emit q->prefetchChildrenChanged(m_prefetchChildren);
+    clearChildPrefetches();
+    m_childPrefetchFirst = -1;
+    m_childPrefetchLast = -1;
 
     //Explicitly call the PagingModel resetModel to also reset the fetched data
     QIviPagingModelPrivate::resetModel();
 }
 
+bool QIviSearchAndBrowseModelPrivate::handleFetchedData(const QList<QVariant> &items, int start, bool moreAvailable)
+{
+    //The children waited for the rows of this model, which are inserted before the timer fires
+    if (m_childPrefetchDeferred && !m_childPrefetchTimer.isActive())
+        m_childPrefetchTimer.start(childPrefetchDelay);
+
+    if (!m_local.active)
+        return false;
+
+    //The chunks are streamed one after the other, everything else is outdated
+    if (start != m_local.fetchedCount)
+        return true;
+
+    m_local.fetchedCount += items.count();
+
+    QVector<int> matches;
+    bool sort = false;
+    for (int i = 0; i < items.count(); i++) {
+        const QIviQueryTermEvaluator *evaluator = localEvaluator(items.at(i));
+        if (!evaluator || !evaluator->matches(items.at(i)))
+            continue;
+
+        matches.append(i);
+        sort = sort || evaluator->hasOrder();
+    }
+
+    //Sort the new rows first, to insert all of them which end up next to each other at once
+    if (sort) {
+        std::stable_sort(matches.begin(), matches.end(), [this, &items](int left, int right) {
+            return localLessThan(items.at(left), items.at(right));
+        });
+    }
+
+    Q_Q(QIviSearchAndBrowseModel);
+    int from = 0;
+    for (int i = 0; i < matches.count();) {
+        const QVariant &item = items.at(matches.at(i));
+        //Equal rows are inserted after the existing ones to keep the sorting stable
+        int row = m_itemList.count();
+        if (sort) {
+            row = std::upper_bound(m_itemList.cbegin() + from, m_itemList.cend(), item, [this](const QVariant &left, const QVariant &right) {
+                return localLessThan(left, right);
+            }) - m_itemList.cbegin();
+        }
+
+        int end = i + 1;
+        while (end < matches.count() && (row == m_itemList.count() || localLessThan(items.at(matches.at(end)), m_itemList.at(row))))
+            end++;
+
+        QList<QVariant> rows;
+        for (int j = i; j < end; j++) {
+            rows.append(items.at(matches.at(j)));
+            m_local.sourceRows.insert(row + j - i, start + matches.at(j));
+        }
+
+        q->beginInsertRows(QModelIndex(), row, row + rows.count() - 1);
+        insertRows(row, rows);
+        q->endInsertRows();
+
+        from = row + rows.count();
+        i = end;
+    }
+
+    //Lets fetchMore() continue the stream instead of requesting the visible row count
+    m_fetchedDataCount = m_local.fetchedCount;
+
+    if (!items.isEmpty() && (moreAvailable || (m_local.count >= 0 && m_local.fetchedCount < m_local.count)))
+        fetchNextLocalChunk();
+    else
+        m_local.complete = true;
+
+    return true;
+}
+
+bool QIviSearchAndBrowseModelPrivate::handleCountChanged(int count)
+{
+    if (!m_local.active)
+        return false;
+
+    //The model only contains the matching rows and doesn't need empty rows for the DataChanged mode
+    m_local.count = count;
+    return true;
+}
+
+bool QIviSearchAndBrowseModelPrivate::handleDataChanged()
+{
+    if (!m_local.active)
+        return false;
+
+    //The changed rows might move to any position, stream the whole content again
+    startLocalQuery();
+    return true;
+}
+
+void QIviSearchAndBrowseModelPrivate::startLocalQuery()
+{
+    Q_Q(QIviSearchAndBrowseModel);
+
+    if (m_sharedCache)
+        m_sharedCache->abandonFetches(this);
+    cancelPendingFetches();
+    updateSharedCache();
+    m_reload.active = false;
+    m_rowsLoadingType = m_loadingType;
+
+    q->beginResetModel();
+    clearModel();
+    m_local.complete = false;
+    m_local.fetchedCount = 0;
+    m_local.count = -1;
+    m_local.evaluators.clear();
+    m_local.sourceRows.clear();
+    //The rows are added while the content is streamed, not by fetchMore()
+    m_moreAvailable = false;
+    q->endResetModel();
+
+    fetchData(0);
+}
+
+void QIviSearchAndBrowseModelPrivate::fetchNextLocalChunk()
+{
+    //Backends might reply synchronously. Returning to the event loop first avoids a deep recursion
+    //and lets the views show the rows which are already sorted.
+    Q_Q(QIviSearchAndBrowseModel);
+    const int generation = m_fetchGeneration;
+    QMetaObject::invokeMethod(q, [this, generation]() {
+        if (m_local.active && generation == m_fetchGeneration)
+            fetchData(m_local.fetchedCount);
+    }, Qt::QueuedConnection);
+}
+
+const QIviQueryTermEvaluator *QIviSearchAndBrowseModelPrivate::localEvaluator(const QVariant &item)
+{
+    const int type = item.userType();
+    auto it = m_local.evaluators.constFind(type);
+    if (it == m_local.evaluators.constEnd()) {
+        const QMetaObject *metaObject = QMetaType::typeFlags(type).testFlag(QMetaType::IsGadget) ? QMetaType::metaObjectForType(type) : nullptr;
+        it = m_local.evaluators.insert(type, QIviQueryTermEvaluator(metaObject, m_local.term.data(), m_local.orderTerms));
+        //The rows of this type can't be filtered, report it only once
+        if (!it->isValid())
+            qtivi_qmlOrCppWarning(q_ptr, it->errorString());
+    }
+
+    return it->isValid() ? &it.value() : nullptr;
+}
+
+bool QIviSearchAndBrowseModelPrivate::localLessThan(const QVariant &left, const QVariant &right)
+{
+    const QIviQueryTermEvaluator *evaluator = localEvaluator(left);
+    return evaluator && evaluator->lessThan(left, right);
+}
+
+int QIviSearchAndBrowseModelPrivate::sourceRow(int row) const
+{
+    if (!m_local.active)
+        return row;
+
+    return m_local.sourceRows.value(row, -1);
+}
+
+void QIviSearchAndBrowseModelPrivate::deliverSharedChunk(int start, const QIviPagingModelSharedCache::Chunk &chunk)
+{
+    //The backend only reports the sections to the instance which fetched the data
+    const QVariantList sections = m_sharedCache->sections();
+    if (!sections.isEmpty())
+        updateSections(sections);
+
+    QIviPagingModelPrivate::deliverSharedChunk(start, chunk);
+
+    if (!chunk.canGoForward.isEmpty())
+        updateCanGoForward(chunk.canGoForward, start);
+}
+
 void QIviSearchAndBrowseModelPrivate::onCanGoForwardChanged(const QUuid &identifier, const QVector<bool> &indexes, int start)
 {
     if (m_identifier != identifier)
         return;
 
-    //Always keep the list size in sync;
-    m_canGoForward.resize(qMax(m_itemList.count(), indexes.count()));
+    updateCanGoForward(indexes, start);
+
+    //The visible rows might be able to go forward now
+    if (m_prefetchChildren && !m_childPrefetchTimer.isActive())
+        m_childPrefetchTimer.start(childPrefetchDelay);
+
+    //The other models sharing the chunk didn't request it from the backend and won't be notified.
+    //All of them use the same interface, as the interface is part of the key.
+    if (m_sharedCache) {
+        m_sharedCache->setCanGoForward(start, indexes);
+        const auto members = m_sharedCache->members();
+        for (QIviPagingModelPrivate *member : members) {
+            if (member != this)
+                static_cast<QIviSearchAndBrowseModelPrivate *>(member)->updateCanGoForward(indexes, start);
+        }
+    }
+}
+
+void QIviSearchAndBrowseModelPrivate::updateCanGoForward(const QVector<bool> &indexes, int start)
+{
+    //Always keep the list size in sync. Models sharing a chunk might not have fetched it yet.
+    m_canGoForward.resize(qMax(m_itemList.count(), start + indexes.count()));
 
     //Update the list
     for (int i = 0; i < indexes.count(); i++)
@@ -180,9 +679,14 @@ void QIviSearchAndBrowseModelPrivate::onContentTypeChanged(const QUuid &identifi
         m_contentType = contentType;
         emit q->contentTypeChanged(m_contentType);
     }
+    clearChildPrefetches();
+    updateSections(QVariantList());
     parseQuery();
 
-    QIviPagingModelPrivate::resetModel();
+    if (m_local.active)
+        startLocalQuery();
+    else if (!restoreNavigationLevel())
+        QIviPagingModelPrivate::resetModel();
 }
 
 void QIviSearchAndBrowseModelPrivate::onAvailableContentTypesChanged(const QStringList &contentTypes)
@@ -203,6 +707,30 @@ void QIviSearchAndBrowseModelPrivate::onQueryIdentifiersChanged(const QUuid &ide
     m_queryIdentifiers = queryIdentifiers;
 }
 
+void QIviSearchAndBrowseModelPrivate::onSectionsChanged(const QUuid &identifier, const QVariantList &sections)
+{
+    if (!identifier.isNull() && m_identifier != identifier)
+        return;
+
+    //The sections refer to the rows of the backend, which are not the rows of a local query
+    if (m_local.active)
+        return;
+
+    if (m_sharedCache && identifier == m_identifier)
+        m_sharedCache->setSections(sections);
+    updateSections(sections);
+}
+
+void QIviSearchAndBrowseModelPrivate::updateSections(const QVariantList &sections)
+{
+    Q_Q(QIviSearchAndBrowseModel);
+    if (m_sections == sections)
+        return;
+
+    m_sections = sections;
+    emit q->sectionsChanged(m_sections);
+}
+
 QIviSearchAndBrowseModelInterface *QIviSearchAndBrowseModelPrivate::searchBackend() const
 {
     return QIviAbstractFeatureListModelPrivate::backend<QIviSearchAndBrowseModelInterface*>();
@@ -211,7 +739,8 @@ QIviSearchAndBrowseModelInterface *QIviSearchAndBrowseModelPrivate::searchBacken
 void QIviSearchAndBrowseModelPrivate::updateContentType(const QString &contentType)
 {
     Q_Q(QIviSearchAndBrowseModel);
-    m_query = QString();
+    //The level which is shown again uses the query it was shown with
+    m_query = m_restoreNavigationLevel ? m_navigationHistory.last().query : QString();
     m_queryIdentifiers.clear();
     emit q->queryChanged(m_query);
     m_contentTypeRequested = contentType;
@@ -221,6 +750,153 @@ void QIviSearchAndBrowseModelPrivate::updateContentType(const QString &contentTy
     resetModel();
 }
 
+void QIviSearchAndBrowseModelPrivate::pushNavigationLevel()
+{
+    //The rows of a local query are mapped to the rows of the backend and would need to be streamed again
+    if (m_local.active || m_contentType.isEmpty())
+        return;
+
+    if (m_navigationHistory.count() >= navigationHistorySize)
+        m_navigationHistory.removeFirst();
+
+    //The rows are implicitly shared and not copied
+    const int anchor = m_viewportFirst >= 0 ? m_viewportFirst : qMax(m_lastAccessedRow, 0);
+    m_navigationHistory.append({m_contentType, m_query, m_loadingType, m_chunkSize,
+                                m_itemList, m_idColumn, m_nameColumn, m_typeColumn, m_canGoForward, anchor});
+}
+
+bool QIviSearchAndBrowseModelPrivate::restoreNavigationLevel()
+{
+    if (!m_restoreNavigationLevel)
+        return false;
+    m_restoreNavigationLevel = false;
+
+    const NavigationLevel level = m_navigationHistory.takeLast();
+    if (level.contentType != m_contentType || level.query != m_query || level.loadingType != m_loadingType
+            || level.chunkSize != m_chunkSize || m_reload.active) {
+        return false;
+    }
+
+    Q_Q(QIviSearchAndBrowseModel);
+    if (m_sharedCache)
+        m_sharedCache->abandonFetches(this);
+    cancelPendingFetches();
+    updateSharedCache();
+    m_rowsLoadingType = m_loadingType;
+
+    q->beginResetModel();
+    clearModel();
+    m_itemList = level.items;
+    m_idColumn = level.ids;
+    m_nameColumn = level.names;
+    m_typeColumn = level.types;
+    m_canGoForward = level.canGoForward;
+    //The rows might be outdated. They are shown until the reload below revalidated them.
+    m_chunkCache.resize((m_itemList.count() + m_chunkSize - 1) / m_chunkSize);
+    m_fetchedDataCount = m_itemList.count();
+    //Further data is fetched once the last chunk got revalidated
+    m_moreAvailable = m_itemList.isEmpty();
+    q->endResetModel();
+
+    emit q->positionRestored(level.anchor);
+
+    //The data might have changed in the meantime, e.g. rows got removed at the end. The reload
+    //reports the differences and trims the rows to the current count. With FetchMore all restored
+    //rows are reloaded, as the rows behind the reloaded ones are removed.
+    if (m_itemList.isEmpty()) {
+        q->fetchMore(QModelIndex());
+    } else {
+        m_lastAccessedRow = level.anchor;
+        startIncrementalReload(m_loadingType == QIviPagingModel::FetchMore ? m_itemList.count() - 1
+                                                                           : level.anchor + m_chunkSize);
+    }
+    return true;
+}
+
+void QIviSearchAndBrowseModelPrivate::onVisibleRowsChanged(int first, int last)
+{
+    if (!m_prefetchChildren)
+        return;
+
+    m_childPrefetchFirst = first;
+    m_childPrefetchLast = last;
+    if (!m_childPrefetchTimer.isActive())
+        m_childPrefetchTimer.start(childPrefetchDelay);
+}
+
+void QIviSearchAndBrowseModelPrivate::updateChildPrefetches()
+{
+    //Going forward is only free of side effects if the backend doesn't keep the navigation state
+    if (!m_prefetchChildren || !searchBackend() || m_childPrefetchFirst < 0
+            || !m_capabilities.testFlag(QtIviCoreModule::SupportsStatelessNavigation)) {
+        clearChildPrefetches();
+        return;
+    }
+
+    //The rows of this model are fetched first, the children are only fetched speculatively.
+    //Nothing changes until the next reply arrives, which starts the timer again.
+    m_childPrefetchDeferred = pendingFetchCount() || m_reload.active;
+    if (m_childPrefetchDeferred)
+        return;
+
+    QHash<QString, QPointer<QIviSearchAndBrowseModel>> prefetches;
+    const int last = qMin(m_childPrefetchLast, m_itemList.count() - 1);
+    for (int row = m_childPrefetchFirst; row <= last && prefetches.count() < childPrefetchLimit; row++) {
+        const QString id = m_idColumn.at(row);
+        if (id.isEmpty() || !m_itemList.at(row).isValid() || !m_canGoForward.value(sourceRow(row), false))
+            continue;
+
+        QPointer<QIviSearchAndBrowseModel> model = m_childPrefetches.take(id);
+        if (!model)
+            model = prefetchChild(row);
+        prefetches.insert(id, model);
+    }
+
+    //The children of the rows which are not visible anymore are not needed
+    qDeleteAll(m_childPrefetches);
+    m_childPrefetches = prefetches;
+}
+
+QIviSearchAndBrowseModel *QIviSearchAndBrowseModelPrivate::prefetchChild(int row)
+{
+    Q_Q(QIviSearchAndBrowseModel);
+    //The model is owned by this instance until goForward() hands it out
+    QPointer<QIviSearchAndBrowseModel> model = new QIviSearchAndBrowseModel(q->serviceObject(), q);
+
+    QIviPendingReply<QString> reply = searchBackend()->goForward(m_identifier, sourceRow(row));
+    reply.then([model](const QString &value) {
+        if (model)
+            model->setContentType(value);
+    },
+    [model]() {
+        //The model is only handed out once its content type is known
+        if (model)
+            model->deleteLater();
+    });
+    return model;
+}
+
+QIviSearchAndBrowseModel *QIviSearchAndBrowseModelPrivate::takeChildPrefetch(int row)
+{
+    const QString id = m_idColumn.value(row);
+    auto it = m_childPrefetches.find(id);
+    if (id.isEmpty() || it == m_childPrefetches.end() || !*it || (*it)->contentType().isEmpty())
+        return nullptr;
+
+    QIviSearchAndBrowseModel *model = *it;
+    m_childPrefetches.erase(it);
+    model->setParent(nullptr);
+    return model;
+}
+
+void QIviSearchAndBrowseModelPrivate::clearChildPrefetches()
+{
+    m_childPrefetchTimer.stop();
+    m_childPrefetchDeferred = false;
+    qDeleteAll(m_childPrefetches);
+    m_childPrefetches.clear();
+}
+
 /*!
     \class QIviSearchAndBrowseModel
     \inmodule QtIviCore
@@ -270,6 +946,9 @@ void QIviSearchAndBrowseModelPrivate::updateContentType(const QString &contentTy
     Filtering and sorting can also be combined in one string and the filter part can also be more complex. More on that
     can be found in the detailed \l {Qt IVI Query Language} Documentation.
 
+    For backends which don't support filtering or sorting, the \l {QIviSearchAndBrowseModel::}{localQuery} property can be enabled
+    to do it within the model instead. This requires fetching all data of the backend.
+
     \section1 Browsing
     \target Browsing
 
@@ -418,6 +1097,9 @@ void QIviSearchAndBrowseModelPrivate::updateContentType(const QString &contentTy
     Filtering and sorting can also be combined in one string and the filter part can also be more complex. More on that
     can be found in the detailed \l {Qt IVI Query Language} Documentation.
 
+    For backends which don't support filtering or sorting, the \l {SearchAndBrowseModel::}{localQuery} property can be enabled
+    to do it within the model instead. This requires fetching all data of the backend.
+
     \section1 Browsing
     \target Browsing
 
@@ -501,7 +1183,7 @@ QIviSearchAndBrowseModel::QIviSearchAndBrowseModel(QObject *parent)
     \note When changing this property the content will be reset.
 
     See \l {Qt IVI Query Language} for more information.
-    \sa FilteringAndSorting
+    \sa FilteringAndSorting, queryDelay
 */
 
 /*!
@@ -511,7 +1193,7 @@ QIviSearchAndBrowseModel::QIviSearchAndBrowseModel(QObject *parent)
     \note When changing this property the content will be reset.
 
     See \l {Qt IVI Query Language} for more information.
-    \sa FilteringAndSorting
+    \sa FilteringAndSorting, queryDelay
 */
 QString QIviSearchAndBrowseModel::query() const
 {
@@ -530,8 +1212,13 @@ void QIviSearchAndBrowseModel::setQuery(const QString &query)
     d->m_query = query;
     emit queryChanged(d->m_query);
 
-    //The query is checked in resetModel
-    d->resetModel();
+    //While typing, only the last query is applied
+    if (d->m_queryDelay > 0) {
+        d->m_queryTimer.start(d->m_queryDelay);
+        return;
+    }
+
+    d->applyQuery();
 }
 
 /*!
@@ -563,6 +1250,7 @@ void QIviSearchAndBrowseModel::setContentType(const QString &contentType)
     if (d->m_contentTypeRequested == contentType)
         return;
 
+    d->m_navigationHistory.clear();
     d->updateContentType(contentType);
 }
 
@@ -604,6 +1292,204 @@ bool QIviSearchAndBrowseModel::canGoBack() const
     return d->m_canGoBack;
 }
 
+/*!
+    \qmlproperty int SearchAndBrowseModel::queryDelay
+    \brief Holds the time in milliseconds a changed query waits before it is applied.
+
+    This enables the search-as-you-type mode, which is useful if the query is changed on every
+    key press: the content is only reset once the query didn't change for the given time. If the
+    new query only narrows the current one, e.g. by extending a \c{name~='Ab*'} filter to
+    \c{name~='Abc*'} or by adding another filter using the \c & conjunction, and all rows are
+    already fetched, the rows which don't match anymore are removed by the model instead of
+    querying the backend again.
+
+    The default value is \c 0, which applies every query immediately.
+
+    \sa query
+*/
+
+/*!
+    \property QIviSearchAndBrowseModel::queryDelay
+    \brief Holds the time in milliseconds a changed query waits before it is applied.
+
+    This enables the search-as-you-type mode, which is useful if the query is changed on every
+    key press: the content is only reset once the query didn't change for the given time. If the
+    new query only narrows the current one, e.g. by extending a \c{name~='Ab*'} filter to
+    \c{name~='Abc*'} or by adding another filter using the \c & conjunction, and all rows are
+    already fetched, the rows which don't match anymore are removed by the model instead of
+    querying the backend again. The narrowed query is evaluated using QIviQueryTermEvaluator.
+
+    The default value is \c 0, which applies every query immediately.
+
+    \sa query
+*/
+int QIviSearchAndBrowseModel::queryDelay() const
+{
+    Q_D(const QIviSearchAndBrowseModel);
+    return d->m_queryDelay;
+}
+
+void QIviSearchAndBrowseModel::setQueryDelay(int queryDelay)
+{
+    Q_D(QIviSearchAndBrowseModel);
+    if (d->m_queryDelay == queryDelay)
+        return;
+
+    d->m_queryDelay = queryDelay;
+    emit queryDelayChanged(queryDelay);
+
+    //A waiting query isn't delayed anymore
+    if (queryDelay <= 0 && d->m_queryTimer.isActive())
+        d->applyQuery();
+}
+
+/*!
+    \qmlproperty bool SearchAndBrowseModel::localQuery
+    \brief Holds whether the parts of the query which are not supported by the backend are evaluated by the model.
+
+    When enabled and the backend doesn't support filtering or sorting, the model fetches the
+    complete content from the backend and only adds the matching rows, in the requested order.
+    The parts the backend supports are still done by the backend. As all data has to be fetched,
+    this should only be used for content types with a limited number of items.
+
+    While the query is evaluated by the model, the rows are not fetched on demand and the insert()
+    and move() functions are not available.
+
+    The default value is \c false.
+
+    \note When changing this property the content will be reset.
+
+    \sa query
+*/
+
+/*!
+    \property QIviSearchAndBrowseModel::localQuery
+    \brief Holds whether the parts of the query which are not supported by the backend are evaluated by the model.
+
+    When enabled and the backend doesn't support filtering or sorting, the model fetches the
+    complete content from the backend and only adds the matching rows, in the requested order.
+    The parts the backend supports are still done by the backend. As all data has to be fetched,
+    this should only be used for content types with a limited number of items.
+
+    While the query is evaluated by the model, the rows are not fetched on demand and the insert()
+    and move() functions are not available.
+
+    The default value is \c false.
+
+    \note When changing this property the content will be reset.
+
+    \sa query, QIviQueryTermEvaluator
+*/
+bool QIviSearchAndBrowseModel::localQuery() const
+{
+    Q_D(const QIviSearchAndBrowseModel);
+    return d->m_localQuery;
+}
+
+void QIviSearchAndBrowseModel::setLocalQuery(bool localQuery)
+{
+    Q_D(QIviSearchAndBrowseModel);
+    if (d->m_localQuery == localQuery)
+        return;
+
+    d->m_localQuery = localQuery;
+    emit localQueryChanged(localQuery);
+
+    //The query is checked in resetModel
+    d->resetModel();
+}
+
+/*!
+    \qmlproperty bool SearchAndBrowseModel::prefetchChildren
+    \brief Holds whether the next level of the visible rows is fetched in the background.
+
+    When enabled, the first chunk of the next level is fetched for the visible rows which can go
+    forward, as soon as the model received the data it needs itself. Calling goForward() with the
+    OutOfModelNavigation on one of these rows returns a model which already contains its first
+    chunk, which makes the navigation appear instant. The visible rows are either set using
+    setViewport() or inferred from the row which was accessed last.
+
+    At most four rows are prefetched at a time. The prefetch is only done if the backend supports
+    the stateless navigation.
+
+    The default value is \c false.
+
+    \sa goForward(), canGoForward()
+*/
+
+/*!
+    \property QIviSearchAndBrowseModel::prefetchChildren
+    \brief Holds whether the next level of the visible rows is fetched in the background.
+
+    When enabled, the first chunk of the next level is fetched for the visible rows which can go
+    forward, as soon as the model received the data it needs itself. Calling goForward() with the
+    OutOfModelNavigation on one of these rows returns a model which already contains its first
+    chunk, which makes the navigation appear instant. The visible rows are either set using
+    setViewport() or inferred from the row which was accessed last.
+
+    At most four rows are prefetched at a time. The prefetch is only done if the backend supports
+    the stateless navigation.
+
+    The default value is \c false.
+
+    \sa goForward(), canGoForward()
+*/
+bool QIviSearchAndBrowseModel::prefetchChildren() const
+{
+    Q_D(const QIviSearchAndBrowseModel);
+    return d->m_prefetchChildren;
+}
+
+void QIviSearchAndBrowseModel::setPrefetchChildren(bool prefetchChildren)
+{
+    Q_D(QIviSearchAndBrowseModel);
+    if (d->m_prefetchChildren == prefetchChildren)
+        return;
+
+    d->m_prefetchChildren = prefetchChildren;
+    emit prefetchChildrenChanged(prefetchChildren);
+
+    if (prefetchChildren)
+        d->m_childPrefetchTimer.start(childPrefetchDelay);
+    else
+        d->clearChildPrefetches();
+}
+
+/*!
+    \qmlproperty list<object> SearchAndBrowseModel::sections
+    \brief Holds the sections of the content, in the order of the rows.
+
+    Every entry holds the key of the section as \c section and the index of its first row as
+    \c index. The media backends e.g. use the first character of the value the rows are sorted
+    by, which makes it possible to jump to all artists starting with "M" without fetching the rows
+    before them. See indexOfSection() for how to use it.
+
+    The sections are only provided by backends supporting the QtIviCoreModule::SupportsSectionIndex
+    capability and are empty while the query is evaluated by the model.
+
+    \sa indexOfSection()
+*/
+
+/*!
+    \property QIviSearchAndBrowseModel::sections
+    \brief Holds the sections of the content, in the order of the rows.
+
+    Every entry holds the key of the section as \c section and the index of its first row as
+    \c index. The media backends e.g. use the first character of the value the rows are sorted
+    by, which makes it possible to jump to all artists starting with "M" without fetching the rows
+    before them. See indexOfSection() for how to use it.
+
+    The sections are only provided by backends supporting the QtIviCoreModule::SupportsSectionIndex
+    capability and are empty while the query is evaluated by the model.
+
+    \sa indexOfSection(), QIviSearchAndBrowseModelInterface::sectionsChanged()
+*/
+QVariantList QIviSearchAndBrowseModel::sections() const
+{
+    Q_D(const QIviSearchAndBrowseModel);
+    return d->m_sections;
+}
+
 /*!
     \reimp
 */
@@ -629,11 +1515,17 @@ QVariant QIviSearchAndBrowseModel::data(const QModelIndex &index, int role) cons
     \qmlmethod void SearchAndBrowseModel::goBack()
     Goes one level back in the navigation history.
 
+    The last levels of the InModelNavigation are kept and shown again immediately, while their rows
+    are revalidated against the backend once they are accessed. See also positionRestored().
+
     See also \l Browsing for more information.
 */
 /*!
     Goes one level back in the navigation history.
 
+    The last levels of the InModelNavigation are kept and shown again immediately, while their rows
+    are revalidated against the backend once they are accessed. See also positionRestored().
+
     See also \l Browsing for more information.
 */
 void QIviSearchAndBrowseModel::goBack()
@@ -654,6 +1546,11 @@ void QIviSearchAndBrowseModel::goBack()
     QIviPendingReply<QString> reply = backend->goBack(d->m_identifier);
     reply.then([this, reply](const QString &value) {
         Q_D(QIviSearchAndBrowseModel);
+        //The history is only valid as long as it follows the navigation of the backend
+        d->m_restoreNavigationLevel = !d->m_navigationHistory.isEmpty()
+                                      && d->m_navigationHistory.last().contentType == value;
+        if (!d->m_restoreNavigationLevel)
+            d->m_navigationHistory.clear();
         d->updateContentType(value);
     },
     [this]() {
@@ -677,7 +1574,9 @@ bool QIviSearchAndBrowseModel::canGoForward(int i) const
     Q_D(const QIviSearchAndBrowseModel);
     QIviSearchAndBrowseModelInterface *backend = d->searchBackend();
 
-    if (i >= d->m_canGoForward.count() || i < 0)
+    //The backend reports the rows of a local query by their position in its unfiltered content
+    const int row = d->sourceRow(i);
+    if (row >= d->m_canGoForward.count() || row < 0)
         return false;
 
     if (!backend) {
@@ -685,7 +1584,7 @@ bool QIviSearchAndBrowseModel::canGoForward(int i) const
         return false;
     }
 
-    return d->m_canGoForward[i];
+    return d->m_canGoForward[row];
 }
 
 /*!
@@ -730,14 +1629,19 @@ QIviSearchAndBrowseModel *QIviSearchAndBrowseModel::goForward(int i, NavigationT
         return nullptr;
     }
 
-    if (!d->m_canGoForward.value(i, false)) {
+    const int row = d->sourceRow(i);
+    if (!d->m_canGoForward.value(row, false)) {
         qtivi_qmlOrCppWarning(this, "Can't go forward anymore");
         return nullptr;
     }
 
     if (navigationType == OutOfModelNavigation) {
         if (d->m_capabilities.testFlag(QtIviCoreModule::SupportsStatelessNavigation)) {
-            QIviPendingReply<QString> reply = backend->goForward(d->m_identifier, i);
+            //The next level might already be fetched in the background
+            if (QIviSearchAndBrowseModel *prefetchedModel = d->takeChildPrefetch(i))
+                return prefetchedModel;
+
+            QIviPendingReply<QString> reply = backend->goForward(d->m_identifier, row);
             auto newModel = new QIviSearchAndBrowseModel(serviceObject());
             reply.then([reply, newModel](const QString &value) {
                 newModel->setContentType(value);
@@ -752,9 +1656,10 @@ QIviSearchAndBrowseModel *QIviSearchAndBrowseModel::goForward(int i, NavigationT
             return nullptr;
         }
     } else {
-        QIviPendingReply<QString> reply = backend->goForward(d->m_identifier, i);
+        QIviPendingReply<QString> reply = backend->goForward(d->m_identifier, row);
         reply.then([this, reply](const QString &value) {
             Q_D(QIviSearchAndBrowseModel);
+            d->pushNavigationLevel();
             d->updateContentType(value);
         },
         [this]() {
@@ -802,6 +1707,11 @@ QIviPendingReply<void> QIviSearchAndBrowseModel::insert(int index, const QVarian
         return QIviPendingReply<void>::createFailedReply();
     }
 
+    if (d->m_local.active) {
+        qtivi_qmlOrCppWarning(this, "Items can't be inserted while the query is evaluated locally");
+        return QIviPendingReply<void>::createFailedReply();
+    }
+
     return backend->insert(d->m_identifier, index, variant);
 }
 
@@ -834,7 +1744,7 @@ QIviPendingReply<void> QIviSearchAndBrowseModel::remove(int index)
         return QIviPendingReply<void>::createFailedReply();
     }
 
-    return backend->remove(d->m_identifier, index);
+    return backend->remove(d->m_identifier, d->sourceRow(index));
 }
 
 /*!
@@ -866,6 +1776,11 @@ QIviPendingReply<void> QIviSearchAndBrowseModel::move(int cur_index, int new_ind
         return QIviPendingReply<void>::createFailedReply();
     }
 
+    if (d->m_local.active) {
+        qtivi_qmlOrCppWarning(this, "Items can't be moved while the query is evaluated locally");
+        return QIviPendingReply<void>::createFailedReply();
+    }
+
     return backend->move(d->m_identifier, cur_index, new_index);
 }
 
@@ -897,7 +1812,76 @@ QIviPendingReply<int> QIviSearchAndBrowseModel::indexOf(const QVariant &variant)
         return QIviPendingReply<int>::createFailedReply();
     }
 
-    return backend->indexOf(d->m_identifier, variant);
+    if (!d->m_local.active)
+        return backend->indexOf(d->m_identifier, variant);
+
+    //The backend returns the position in its unfiltered content
+    QIviPendingReply<int> indexReply = backend->indexOf(d->m_identifier, variant);
+    QIviPendingReply<int> reply;
+    indexReply.then([this, reply](int index) mutable {
+        Q_D(QIviSearchAndBrowseModel);
+        reply.setSuccess(d->m_local.sourceRows.indexOf(index));
+    },
+    [reply]() mutable {
+        reply.setFailed();
+    });
+    return reply;
+}
+
+/*!
+    \qmlmethod int SearchAndBrowseModel::indexOfSection(string section)
+
+    Returns the index of the first row of \a section, or \c -1 if the section is not part of the
+    sections property.
+
+    In the DataChanged loading type, the chunk containing the row is fetched right away, which
+    makes the rows of the section available by the time the view is positioned at the returned
+    index. In the FetchMore loading type the rows before the section need to be fetched first.
+
+    \code
+    ListView {
+        id: listView
+        model: SearchAndBrowseModel {
+            contentType: "artist"
+            loadingType: SearchAndBrowseModel.DataChanged
+        }
+    }
+
+    Button {
+        text: "M"
+        onClicked: listView.positionViewAtIndex(listView.model.indexOfSection(text), ListView.Beginning)
+    }
+    \endcode
+
+    \sa sections
+*/
+
+/*!
+    Returns the index of the first row of \a section, or \c -1 if the section is not part of the
+    sections property.
+
+    In the DataChanged loading type, the chunk containing the row is fetched right away, which
+    makes the rows of the section available by the time the view is positioned at the returned
+    index. In the FetchMore loading type the rows before the section need to be fetched first.
+
+    \sa sections
+*/
+int QIviSearchAndBrowseModel::indexOfSection(const QString &section)
+{
+    Q_D(QIviSearchAndBrowseModel);
+    for (const QVariant &entry : qAsConst(d->m_sections)) {
+        const QVariantMap map = entry.toMap();
+        if (map.value(QStringLiteral("section")).toString() != section)
+            continue;
+
+        const int row = map.value(QStringLiteral("index")).toInt();
+        const int chunkIndex = row / d->m_chunkSize;
+        if (row < d->m_itemList.count() && d->m_chunkCache.isChunkMissing(chunkIndex))
+            d->fetchData(chunkIndex * d->m_chunkSize);
+        return row;
+    }
+
+    return -1;
 }
 
 /*!
@@ -951,6 +1935,8 @@ void QIviSearchAndBrowseModel::connectToServiceObject(QIviServiceObject *service
                             d, &QIviSearchAndBrowseModelPrivate::onCanGoBackChanged);
     QObjectPrivate::connect(backend, &QIviSearchAndBrowseModelInterface::canGoForwardChanged,
                             d, &QIviSearchAndBrowseModelPrivate::onCanGoForwardChanged);
+    QObjectPrivate::connect(backend, &QIviSearchAndBrowseModelInterface::sectionsChanged,
+                            d, &QIviSearchAndBrowseModelPrivate::onSectionsChanged);
 
     QIviPagingModel::connectToServiceObject(serviceObject);
 
@@ -966,6 +1952,30 @@ void QIviSearchAndBrowseModel::clearServiceObject()
     d->clearToDefaults();
 }
 
+/*!
+    \fn void QIviSearchAndBrowseModel::positionRestored(int index)
+
+    This signal is emitted when going back shows the previous level again, without waiting for the
+    backend. The \a index is the row, which was shown first when the level was left, and can be used
+    to restore the position of the view.
+
+    The rows of the level are revalidated against the backend once they are accessed.
+
+    \sa goBack()
+*/
+
+/*!
+    \qmlsignal SearchAndBrowseModel::positionRestored(int index)
+
+    This signal is emitted when going back shows the previous level again, without waiting for the
+    backend. The \a index is the row, which was shown first when the level was left, and can be used
+    to restore the position of the view.
+
+    The rows of the level are revalidated against the backend once they are accessed.
+
+    \sa goBack()
+*/
+
 QT_END_NAMESPACE
 
 #include "moc_qivisearchandbrowsemodel.cpp"
@@ -58,9 +58,13 @@ class Q_QTIVICORE_EXPORT QIviSearchAndBrowseModel : public QIviPagingModel
     Q_OBJECT
 
     Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged)
+    Q_PROPERTY(int queryDelay READ queryDelay WRITE setQueryDelay NOTIFY queryDelayChanged)
     Q_PROPERTY(QString contentType READ contentType WRITE setContentType NOTIFY contentTypeChanged)
     Q_PROPERTY(QStringList availableContentTypes READ availableContentTypes NOTIFY availableContentTypesChanged)
     Q_PROPERTY(bool canGoBack READ canGoBack NOTIFY canGoBackChanged)
+    Q_PROPERTY(bool localQuery READ localQuery WRITE setLocalQuery NOTIFY localQueryChanged)
+    Q_PROPERTY(bool prefetchChildren READ prefetchChildren WRITE setPrefetchChildren NOTIFY prefetchChildrenChanged)
+    Q_PROPERTY(QVariantList sections READ sections NOTIFY sectionsChanged)
 
 public:
 
@@ -81,6 +85,9 @@ public:
     QString query() const;
     void setQuery(const QString &query);
 
+    int queryDelay() const;
+    void setQueryDelay(int queryDelay);
+
     QString contentType() const;
     void setContentType(const QString &contentType);
 
@@ -88,6 +95,14 @@ public:
 
     bool canGoBack() const;
 
+    bool localQuery() const;
+    void setLocalQuery(bool localQuery);
+
+    bool prefetchChildren() const;
+    void setPrefetchChildren(bool prefetchChildren);
+
+    QVariantList sections() const;
+
     QVariant data(const QModelIndex &index, int role) const override;
 
     QHash<int, QByteArray> roleNames() const override;
@@ -99,12 +114,18 @@ public:
     Q_INVOKABLE QIviPendingReply<void> remove(int index);
     Q_INVOKABLE QIviPendingReply<void> move(int cur_index, int new_index);
     Q_INVOKABLE QIviPendingReply<int> indexOf(const QVariant &variant);
+    Q_INVOKABLE int indexOfSection(const QString &section);
 
 Q_SIGNALS:
     void queryChanged(const QString &query);
+    void queryDelayChanged(int queryDelay);
     void contentTypeChanged(const QString &contentType);
     void availableContentTypesChanged(const QStringList &availableContentTypes);
     void canGoBackChanged(bool canGoBack);
+    void localQueryChanged(bool localQuery);
+    void prefetchChildrenChanged(bool prefetchChildren);
+    void sectionsChanged(const QVariantList &sections);
+    void positionRestored(int index);
 
 protected:
     QIviSearchAndBrowseModel(QIviServiceObject *serviceObject, QObject *parent = nullptr);
@@ -58,11 +58,16 @@
 #include <private/qtiviglobal_p.h>
 
 #include "qiviqueryterm.h"
+#include "qiviquerytermevaluator.h"
 #include "qivisearchandbrowsemodel.h"
 #include "qivisearchandbrowsemodelinterface.h"
 #include "qivistandarditem.h"
 
 #include <QBitArray>
+#include <QHash>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QTimer>
 #include <QUuid>
 
 QT_BEGIN_NAMESPACE
@@ -70,36 +75,111 @@ QT_BEGIN_NAMESPACE
 class Q_QTIVICORE_EXPORT QIviSearchAndBrowseModelPrivate : public QIviPagingModelPrivate
 {
 public:
+    //A parsed query is never modified and can be used by all models with the same query
+    struct ParsedQuery {
+        QSharedPointer<QIviAbstractQueryTerm> term;
+        QList<QIviOrderTerm> orderTerms;
+        QString error;
+    };
+
+    //The state of a query which is evaluated by the model instead of the backend
+    struct LocalQuery {
+        bool active;
+        bool complete;
+        int fetchedCount;
+        int count;
+        QSharedPointer<QIviAbstractQueryTerm> term;
+        QList<QIviOrderTerm> orderTerms;
+        QHash<int, QIviQueryTermEvaluator> evaluators;
+        QVector<int> sourceRows;
+    };
+
+    //A level of the InModelNavigation, which is shown again when going back to it
+    struct NavigationLevel {
+        QString contentType;
+        QString query;
+        QIviPagingModel::LoadingType loadingType;
+        int chunkSize;
+        QVector<QVariant> items;
+        QVector<QString> ids;
+        QVector<QString> names;
+        QVector<QString> types;
+        QVector<bool> canGoForward;
+        int anchor;
+    };
+
     QIviSearchAndBrowseModelPrivate(const QString &interface, QIviSearchAndBrowseModel *model);
     ~QIviSearchAndBrowseModelPrivate() override;
 
     void resetModel() override;
+    QString cacheKey() const override;
     void parseQuery();
-    void setupFilter(QIviAbstractQueryTerm* queryTerm, const QList<QIviOrderTerm> &orderTerms);
+    void applyQuery();
+    bool refineQuery();
+    static bool narrowsQuery(const QIviAbstractQueryTerm *term, const QIviAbstractQueryTerm *previous);
+    static ParsedQuery parsedQuery(const QString &query, const QSet<QString> &identifiers);
+    void setupFilter(const QSharedPointer<QIviAbstractQueryTerm> &queryTerm, const QList<QIviOrderTerm> &orderTerms);
     void clearToDefaults() override;
+    bool handleFetchedData(const QList<QVariant> &items, int start, bool moreAvailable) override;
+    bool handleCountChanged(int count) override;
+    bool handleDataChanged() override;
+    void startLocalQuery();
+    void fetchNextLocalChunk();
+    const QIviQueryTermEvaluator *localEvaluator(const QVariant &item);
+    bool localLessThan(const QVariant &left, const QVariant &right);
+    int sourceRow(int row) const;
+    void deliverSharedChunk(int start, const QIviPagingModelSharedCache::Chunk &chunk) override;
     void onCanGoForwardChanged(const QUuid &identifier, const QVector<bool> &indexes, int start);
+    void updateCanGoForward(const QVector<bool> &indexes, int start);
     void onCanGoBackChanged(const QUuid &identifier, bool canGoBack);
     void onContentTypeChanged(const QUuid &identifier, const QString &contentType);
     void onAvailableContentTypesChanged(const QStringList &contentTypes);
     void onQueryIdentifiersChanged(const QUuid &identifier, const QSet<QString> &queryIdentifiers);
+    void onSectionsChanged(const QUuid &identifier, const QVariantList &sections);
+    void updateSections(const QVariantList &sections);
 
     QIviSearchAndBrowseModelInterface *searchBackend() const;
     void updateContentType(const QString &contentType);
+    void pushNavigationLevel();
+    bool restoreNavigationLevel();
+    void onVisibleRowsChanged(int first, int last) override;
+    void updateChildPrefetches();
+    QIviSearchAndBrowseModel *prefetchChild(int row);
+    QIviSearchAndBrowseModel *takeChildPrefetch(int row);
+    void clearChildPrefetches();
 
     QIviSearchAndBrowseModel * const q_ptr;
     Q_DECLARE_PUBLIC(QIviSearchAndBrowseModel)
 
     QString m_query;
+    QString m_appliedQuery;
+    int m_queryDelay;
+    QTimer m_queryTimer;
 
-    QIviAbstractQueryTerm *m_queryTerm;
+    QSharedPointer<QIviAbstractQueryTerm> m_queryTerm;
     QList<QIviOrderTerm> m_orderTerms;
 
+    bool m_localQuery;
+    LocalQuery m_local;
+
     QString m_contentTypeRequested;
     QString m_contentType;
     QStringList m_availableContentTypes;
     QSet<QString> m_queryIdentifiers;
     QVector<bool> m_canGoForward;
     bool m_canGoBack;
+    QVariantList m_sections;
+    QVector<NavigationLevel> m_navigationHistory;
+    bool m_restoreNavigationLevel;
+
+    bool m_prefetchChildren;
+    int m_childPrefetchFirst;
+    int m_childPrefetchLast;
+    QTimer m_childPrefetchTimer;
+    //The children are fetched once the rows of this model arrived
+    bool m_childPrefetchDeferred;
+    //The models of the next level, indexed by the id of the row they belong to
+    QHash<QString, QPointer<QIviSearchAndBrowseModel>> m_childPrefetches;
 };
 
 QT_END_NAMESPACE
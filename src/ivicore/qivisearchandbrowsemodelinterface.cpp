@@ -238,4 +238,22 @@ QSet<QString> QIviSearchAndBrowseModelInterface::identifiersFromItem(const QMeta
     possible identifiers.
 */
 
+/*!
+    \fn QIviSearchAndBrowseModelInterface::sectionsChanged(const QUuid &identifier, const QVariantList &sections)
+
+    Emitted to inform the QIviSearchAndBrowseModel instance identified by \a identifier about the
+    sections of its content, in the current order of the rows. This makes it possible to jump to
+    a section, e.g. to all artists starting with "M", without fetching all rows before it.
+
+    Every entry of \a sections is a QVariantMap, which holds the key of the section as \c section
+    and the index of its first row as \c index. The entries are expected to be in the order of
+    the rows.
+
+    Backends emitting this signal should report the QtIviCoreModule::SupportsSectionIndex
+    capability. The signal is expected to be emitted once the model instance has requested data
+    for the first time after the content type or the filter changed.
+
+    \sa QIviSearchAndBrowseModel::sections
+*/
+
 QT_END_NAMESPACE
@@ -84,6 +84,7 @@ Q_SIGNALS:
     void contentTypeChanged(const QUuid &identifier, const QString &contentType);
     void availableContentTypesChanged(const QStringList &availableContentTypes);
     void queryIdentifiersChanged(const QUuid &identifier, const QSet<QString> &queryIdentifiers);
+    void sectionsChanged(const QUuid &identifier, const QVariantList &sections);
 
 protected:
     template <typename T>
@@ -41,6 +41,7 @@
 ****************************************************************************/
 
 #include "qivistandarditem.h"
+#include <QDataStream>
 
 QT_BEGIN_NAMESPACE
 
@@ -187,4 +188,33 @@ bool QIviStandardItem::operator==(const QIviStandardItem &other)
     \sa operator==()
 */
 
+/*!
+    \relates QIviStandardItem
+
+    Writes the id and the data of \a obj to the \a stream. The stream operators are registered
+    with the meta type system, which lets a QIviPagingModel store the items in its snapshot.
+*/
+QDataStream &operator<<(QDataStream &stream, const QIviStandardItem &obj)
+{
+    stream << obj.id();
+    stream << QVariant(obj.data());
+    return stream;
+}
+
+/*!
+    \relates QIviStandardItem
+
+    Reads the id and the data of \a obj from the \a stream.
+*/
+QDataStream &operator>>(QDataStream &stream, QIviStandardItem &obj)
+{
+    QString id;
+    QVariant data;
+    stream >> id;
+    stream >> data;
+    obj.setId(id);
+    obj.setData(data.toMap());
+    return stream;
+}
+
 QT_END_NAMESPACE
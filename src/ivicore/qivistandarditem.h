@@ -51,6 +51,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class QDataStream;
 class QIviStandardItemPrivate;
 
 class Q_QTIVICORE_EXPORT QIviStandardItem
@@ -84,6 +85,9 @@ private:
 
 Q_DECLARE_TYPEINFO(QIviStandardItem, Q_MOVABLE_TYPE);
 
+Q_QTIVICORE_EXPORT QDataStream &operator<<(QDataStream &stream, const QIviStandardItem &obj);
+Q_QTIVICORE_EXPORT QDataStream &operator>>(QDataStream &stream, QIviStandardItem &obj);
+
 using QIviSearchAndBrowseModelItem = QIviStandardItem;
 
 QT_END_NAMESPACE
@@ -0,0 +1,90 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#include "qiviutils_p.h"
+
+#include <QSet>
+
+QT_BEGIN_NAMESPACE
+
+bool qtivi_findMovedRow(const QStringList &oldIds, const QStringList &newIds, int *from, int *to)
+{
+    const int count = oldIds.count();
+    if (count < 2 || newIds.count() != count)
+        return false;
+
+    //Without a unique id the rows can't be matched, e.g. [X, X] would look like a move
+    QSet<QString> ids;
+    ids.reserve(count);
+    for (const QString &id : oldIds) {
+        if (id.isEmpty() || ids.contains(id))
+            return false;
+        ids.insert(id);
+    }
+
+    //The first item moved to the end of the range
+    if (newIds.last() == oldIds.first()) {
+        int i = 0;
+        while (i < count - 1 && newIds.at(i) == oldIds.at(i + 1))
+            i++;
+        if (i == count - 1) {
+            *from = 0;
+            *to = count - 1;
+            return true;
+        }
+    }
+
+    //The last item moved to the beginning of the range
+    if (newIds.first() == oldIds.last()) {
+        int i = 0;
+        while (i < count - 1 && newIds.at(i + 1) == oldIds.at(i))
+            i++;
+        if (i == count - 1) {
+            *from = count - 1;
+            *to = 0;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+QT_END_NAMESPACE
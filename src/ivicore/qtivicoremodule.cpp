@@ -48,6 +48,7 @@
 #include "qiviserviceobject.h"
 #include "qivipagingmodel.h"
 #include "qivisearchandbrowsemodel.h"
+#include "qivistandarditem.h"
 
 #include <QQmlEngine>
 
@@ -107,6 +108,11 @@ QObject* serviceManagerSingelton(QQmlEngine *, QJSEngine *)
            The backend supports moving items within the model.
     \value SupportsRemove
            The backend supports removing items from the model.
+    \value SupportsSectionIndex
+           The backend reports the sections of the content in its current order. See QIviSearchAndBrowseModelInterface::sectionsChanged().
+    \value SupportsSharedResults
+           The backend answers every request solely based on the query of the instance and informs all instances about changes of the data. This makes it possible
+           to share the fetched data between instances using the same query, see QIviPagingModel::sharedCache.
 */
 QtIviCoreModule::QtIviCoreModule(QObject *parent)
     : QObject(parent)
@@ -141,6 +147,11 @@ QtIviCoreModule::QtIviCoreModule(QObject *parent)
            The backend supports moving items within the model.
     \value SupportsRemove
            The backend supports removing items from the model.
+    \value SupportsSectionIndex
+           The backend reports the sections of the content in its current order. See QIviSearchAndBrowseModelInterface::sectionsChanged().
+    \value SupportsSharedResults
+           The backend answers every request solely based on the query of the instance and informs all instances about changes of the data. This makes it possible
+           to share the fetched data between instances using the same query, see QIviPagingModel::sharedCache.
 */
 
 /*!
@@ -152,6 +163,8 @@ void QtIviCoreModule::registerTypes()
     qRegisterMetaType<QList<QIviServiceObject*>>("QList<QIviServiceObject*>");
     qRegisterMetaType<QtIviCoreModule::ModelCapabilities>();
     qIviRegisterPendingReplyType<QtIviCoreModule::ModelCapabilities>();
+    qRegisterMetaType<QIviStandardItem>();
+    qRegisterMetaTypeStreamOperators<QIviStandardItem>();
 }
 
 /*!
@@ -64,7 +64,9 @@ public:
         SupportsStatelessNavigation = 0x20, // (the backend supports to have multiple models showing different contentTypes and filters at the same time)
         SupportsInsert = 0x40,
         SupportsMove = 0x80,
-        SupportsRemove = 0x100
+        SupportsRemove = 0x100,
+        SupportsSectionIndex = 0x200,
+        SupportsSharedResults = 0x400 // (the results only depend on the query, not on the instance requesting them)
     };
     Q_DECLARE_FLAGS(ModelCapabilities, ModelCapability)
     Q_FLAG(ModelCapabilities)
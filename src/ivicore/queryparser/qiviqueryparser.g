@@ -115,6 +115,80 @@ void readQueryBuffer(char *buffer, unsigned int &numBytesRead,int maxBytesToRead
     *currentOffset += numBytesToRead;
 }
 
+//Owns the terms created by QIviQueryParser::parse(QStringView). The memory is taken from a block
+//which is part of the arena itself, only long queries need additional blocks. Objects created
+//with create() are destroyed in reverse order together with the arena.
+class QIviQueryTermArena
+{
+public:
+    QIviQueryTermArena()
+        : m_current(m_firstBlock)
+        , m_end(m_firstBlock + sizeof(m_firstBlock))
+        , m_blocks(nullptr)
+        , m_cleanups(nullptr)
+    {
+    }
+
+    ~QIviQueryTermArena()
+    {
+        for (Cleanup *cleanup = m_cleanups; cleanup; cleanup = cleanup->previous)
+            cleanup->destroy(cleanup + 1);
+
+        while (m_blocks) {
+            Block *block = m_blocks;
+            m_blocks = block->previous;
+            ::operator delete(block);
+        }
+    }
+
+    void *allocate(size_t size)
+    {
+        size = (size + Alignment - 1) & ~(Alignment - 1);
+        if (size > size_t(m_end - m_current)) {
+            const size_t blockSize = sizeof(Block) + qMax(size, sizeof(m_firstBlock));
+            Block *block = static_cast<Block*>(::operator new(blockSize));
+            block->previous = m_blocks;
+            m_blocks = block;
+            m_current = reinterpret_cast<char*>(block + 1);
+            m_end = reinterpret_cast<char*>(block) + blockSize;
+        }
+
+        void *memory = m_current;
+        m_current += size;
+        return memory;
+    }
+
+    template <typename T> T *create()
+    {
+        Cleanup *cleanup = static_cast<Cleanup*>(allocate(sizeof(Cleanup) + sizeof(T)));
+        T *object = new (cleanup + 1) T;
+        cleanup->destroy = [](void *memory) { static_cast<T*>(memory)->~T(); };
+        cleanup->previous = m_cleanups;
+        m_cleanups = cleanup;
+        return object;
+    }
+
+private:
+    Q_DISABLE_COPY(QIviQueryTermArena)
+
+    static const size_t Alignment = alignof(std::max_align_t);
+
+    struct alignas(std::max_align_t) Block {
+        Block *previous;
+    };
+
+    struct alignas(std::max_align_t) Cleanup {
+        void (*destroy)(void *object);
+        Cleanup *previous;
+    };
+
+    alignas(std::max_align_t) char m_firstBlock[1024];
+    char *m_current;
+    char *m_end;
+    Block *m_blocks;
+    Cleanup *m_cleanups;
+};
+
 class QIviQueryParser: protected $table
 {
 public:
@@ -129,6 +203,8 @@ public:
     ~QIviQueryParser();
 
     QIviAbstractQueryTerm *parse();
+    //Parses query without copying it. The terms are owned by the returned pointer
+    QSharedPointer<QIviAbstractQueryTerm> parse(QStringView query);
 
     void setQuery(const QString& query)
     {
@@ -168,6 +244,27 @@ protected:
     void calcCurrentColumn();
 
     int nextToken();
+    int scanToken();
+    int scanString(int begin) const;
+    int scanNumber(int begin, int *token) const;
+
+    int readToken()
+    {
+        return m_arena ? scanToken() : nextToken();
+    }
+
+    ushort charAt(int index) const
+    {
+        return index < m_view.size() ? m_view.at(index).unicode() : 0;
+    }
+
+    QString tokenText() const;
+
+    QIviAbstractQueryTerm *parseTerms();
+
+    template <typename Term, typename Private> Term *createTerm();
+    void deleteTerm(QIviAbstractQueryTerm *term);
+    void deleteTermStack();
 
     void handleConjunction(bool bangOperator);
     void handleScope(bool bang);
@@ -179,10 +276,13 @@ protected:
 protected:
     QString m_query;
     unsigned int m_offset;
+    QStringView m_view;
+    QIviQueryTermArena *m_arena;
     QString m_error;
     QSet<QString> m_identifierList;
 
     int column;
+    int m_tokenLength;
     int tos;
     QVector<QVariant> sym_stack;
     QVector<int> state_stack;
@@ -213,7 +313,9 @@ inline void QIviQueryParser::reallocateStack()
 
 QIviQueryParser::QIviQueryParser():
     m_offset(0),
+    m_arena(nullptr),
     column(0),
+    m_tokenLength(0),
     tos(0)
 {
       reallocateStack();
@@ -291,7 +393,7 @@ void QIviQueryParser::handleConjunction(bool bangOperator)
     if (conjunction1 && conjunction2) {
         conjunction1->d_func()->m_terms += conjunction2->d_func()->m_terms;
         conjunction2->d_func()->m_terms.clear();
-        delete conjunction2;
+        deleteTerm(conjunction2);
         m_termStack.push(conjunction1);
     } else if (conjunction1) {
         conjunction1->d_func()->m_terms.prepend(list.at(1));
@@ -300,7 +402,7 @@ void QIviQueryParser::handleConjunction(bool bangOperator)
         conjunction2->d_func()->m_terms.prepend(list.at(0));
         m_termStack.push(conjunction2);
     } else {
-        QIviConjunctionTerm *term = new QIviConjunctionTerm();
+        QIviConjunctionTerm *term = createTerm<QIviConjunctionTerm, QIviConjunctionTermPrivate>();
         term->d_func()->m_conjunction = conjunction;
         term->d_func()->m_terms = list;
         m_termStack.push(term);
@@ -314,7 +416,7 @@ void QIviQueryParser::handleScope(bool bangOperator)
     if (bangOperator)
         negateLeftMostTerm(term);
 
-    QIviScopeTerm *scopeTerm = new QIviScopeTerm();
+    QIviScopeTerm *scopeTerm = createTerm<QIviScopeTerm, QIviScopeTermPrivate>();
     scopeTerm->d_func()->m_term = term;
     m_termStack.push(scopeTerm);
 }
@@ -328,7 +430,7 @@ bool QIviQueryParser::checkIdentifier(const QString &identifer)
 
         setErrorString(errorMessage);
 
-        qDeleteAll(m_termStack);
+        deleteTermStack();
 
         return false;
     }
@@ -336,35 +438,289 @@ bool QIviQueryParser::checkIdentifier(const QString &identifer)
     return true;
 }
 
+static bool isQueryDigit(ushort c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static bool isQueryOctDigit(ushort c)
+{
+    return c >= '0' && c <= '7';
+}
+
+static bool isQueryHexDigit(ushort c)
+{
+    return isQueryDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+static bool isQueryIdentifierStart(ushort c)
+{
+    return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+static bool isQuerySpace(ushort c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+//Tokenizes m_view in place, following the rules of qiviqueryparser.l.
+//The position of the next token is the current column.
+int QIviQueryParser::scanToken()
+{
+    const int begin = column;
+    if (begin >= m_view.size()) {
+        m_tokenLength = 0;
+        return EOF_SYMBOL;
+    }
+
+    const ushort c = charAt(begin);
+    int length = 1;
+    int token = ERROR;
+
+    const auto choose = [this, begin, &length](ushort second, int longToken, int shortToken) {
+        length = charAt(begin + 1) == second ? 2 : 1;
+        return length == 2 ? longToken : shortToken;
+    };
+
+    switch (c) {
+    case '!': token = choose('=', NE_OP, BANG); break;
+    case '>': token = choose('=', GE_OP, GT_OP); break;
+    case '<': token = choose('=', LE_OP, LT_OP); break;
+    case '|': token = choose('|', OR_OP, OR_OP2); break;
+    case '&': token = choose('&', AND_OP, AND_OP2); break;
+    case '~': token = choose('=', IC_EQ_OP, ERROR); break;
+    case '=': token = choose('=', EQ_OP, EQ_OP2); break;
+    case '(': token = LEFT_PAREN; break;
+    case ')': token = RIGHT_PAREN; break;
+    case '/': token = ASCENDING; break;
+    case '\\': token = DESCENDING; break;
+    case '[': token = LEFT_BRACKET; break;
+    case ']': token = RIGHT_BRACKET; break;
+    case '"':
+    case '\'':
+        if (const int stringLength = scanString(begin)) {
+            length = stringLength;
+            token = STRING;
+            yylval = m_view.mid(begin + 1, length - 2).toString();
+        }
+        break;
+    default:
+        if (isQueryIdentifierStart(c)) {
+            while (isQueryIdentifierStart(charAt(begin + length)) || isQueryDigit(charAt(begin + length)))
+                ++length;
+            token = IDENTIFIER;
+            yylval = m_view.mid(begin, length).toString();
+        } else if (isQuerySpace(c)) {
+            while (isQuerySpace(charAt(begin + length)))
+                ++length;
+            token = SPACE;
+        } else if (const int numberLength = scanNumber(begin, &token)) {
+            length = numberLength;
+            QVarLengthArray<char, 32> text;
+            for (int i = begin; i < begin + length; ++i)
+                text.append(char(charAt(i)));
+            text.append('\0');
+
+            if (token == INTCONSTANT)
+                yylval = int(strtol(text.constData(), nullptr, 0));
+            else
+                yylval = QByteArray::fromRawData(text.constData(), length).toDouble();
+        }
+        break;
+    }
+
+    m_tokenLength = length;
+    column += length;
+    return token;
+}
+
+//Returns the length of the string starting at begin including its quotes, or 0 if it isn't closed.
+//Like (\\.|[^"])* in the flex rules, an escaped quote can either be part of the string or end it
+//and the longest match wins.
+int QIviQueryParser::scanString(int begin) const
+{
+    const QChar quote = m_view.at(begin);
+    int length = 0;
+    bool reachable = true;
+    bool nextReachable = false;
+    for (int i = begin + 1; i < m_view.size() && (reachable || nextReachable); ++i) {
+        bool afterNextReachable = false;
+        if (reachable) {
+            const QChar c = m_view.at(i);
+            if (c == quote)
+                length = i - begin + 1;
+            else
+                nextReachable = true;
+
+            if (c == QLatin1Char('\\') && i + 1 < m_view.size() && m_view.at(i + 1) != QLatin1Char('\n'))
+                afterNextReachable = true;
+        }
+        reachable = nextReachable;
+        nextReachable = afterNextReachable;
+    }
+
+    return length;
+}
+
+//Returns the length of the longest number starting at begin and sets token to its type.
+//Like in flex, an integer wins over a float of the same length.
+int QIviQueryParser::scanNumber(int begin, int *token) const
+{
+    const auto at = [this, begin](int index) {
+        return charAt(begin + index);
+    };
+    const auto count = [&at](int index, bool (*matches)(ushort)) {
+        int length = 0;
+        while (matches(at(index + length)))
+            ++length;
+        return length;
+    };
+    const auto exponent = [&at, &count](int index, ushort lower, ushort upper) {
+        if (at(index) != lower && at(index) != upper)
+            return 0;
+        const int sign = at(index + 1) == '+' || at(index + 1) == '-' ? 1 : 0;
+        const int digits = count(index + 1 + sign, isQueryDigit);
+        return digits ? 1 + sign + digits : 0;
+    };
+
+    //{icst}
+    const int sign = at(0) == '+' || at(0) == '-' ? 1 : 0;
+    int intLength = 0;
+    if (at(sign) == '0') {
+        if ((at(sign + 1) == 'x' || at(sign + 1) == 'X') && isQueryHexDigit(at(sign + 2)))
+            intLength = sign + 2 + count(sign + 2, isQueryHexDigit);
+        else
+            intLength = sign + 1 + count(sign + 1, isQueryOctDigit);
+    } else if (isQueryDigit(at(sign))) {
+        intLength = sign + count(sign, isQueryDigit);
+    }
+
+    //{fract}{exp}? and {digit}+{exp}
+    int floatLength = 0;
+    const int point = sign + count(sign, isQueryDigit);
+    if (at(point) == '.') {
+        const int decimals = count(point + 1, isQueryDigit);
+        if (decimals)
+            floatLength = point + 1 + decimals + exponent(point + 1 + decimals, 'e', 'E');
+    }
+    const int digits = count(0, isQueryDigit);
+    if (digits) {
+        if (at(digits) == '.')
+            floatLength = qMax(floatLength, digits + 1 + exponent(digits + 1, 'e', 'E'));
+        if (const int exp = exponent(digits, 'e', 'E'))
+            floatLength = qMax(floatLength, digits + exp);
+    }
+
+    //0[xX]{hexfract}{binexp} and 0[xX]{hex}+{binexp}
+    if (at(0) == '0' && (at(1) == 'x' || at(1) == 'X')) {
+        const int hexDigits = count(2, isQueryHexDigit);
+        int mantissas[3] = { hexDigits ? 2 + hexDigits : 0, 0, 0 };
+        if (at(2 + hexDigits) == '.') {
+            const int fraction = count(3 + hexDigits, isQueryHexDigit);
+            mantissas[1] = fraction ? 3 + hexDigits + fraction : 0;
+            mantissas[2] = hexDigits ? 3 + hexDigits : 0;
+        }
+        for (int mantissa : mantissas) {
+            if (!mantissa)
+                continue;
+            if (const int exp = exponent(mantissa, 'p', 'P'))
+                floatLength = qMax(floatLength, mantissa + exp);
+        }
+    }
+
+    if (floatLength > intLength) {
+        *token = FLOATCONSTANT;
+        return floatLength;
+    }
+
+    if (intLength)
+        *token = INTCONSTANT;
+    return intLength;
+}
+
+QString QIviQueryParser::tokenText() const
+{
+    if (m_arena)
+        return m_view.mid(column - m_tokenLength, m_tokenLength).toString();
+    return QLatin1String(yytext);
+}
+
+template <typename Term, typename Private>
+Term *QIviQueryParser::createTerm()
+{
+    if (!m_arena)
+        return new Term();
+
+    //The term is never destroyed, it doesn't own anything outside of the arena
+    return new (m_arena->allocate(sizeof(Term))) Term(m_arena->create<Private>());
+}
+
+void QIviQueryParser::deleteTerm(QIviAbstractQueryTerm *term)
+{
+    if (!m_arena)
+        delete term;
+}
+
+void QIviQueryParser::deleteTermStack()
+{
+    if (!m_arena)
+        qDeleteAll(m_termStack);
+    m_termStack.clear();
+}
+
 QIviAbstractQueryTerm *QIviQueryParser::parse()
+{
+    m_offset = 0;
+    yyrestart(yyin);
+
+    return parseTerms();
+}
+
+QSharedPointer<QIviAbstractQueryTerm> QIviQueryParser::parse(QStringView query)
+{
+    QScopedPointer<QIviQueryTermArena> arena(new QIviQueryTermArena);
+    m_view = query;
+    m_arena = arena.data();
+    QIviAbstractQueryTerm *term = parseTerms();
+    m_arena = nullptr;
+    m_view = QStringView();
+
+    if (!term)
+        return QSharedPointer<QIviAbstractQueryTerm>();
+
+    //The whole tree is freed at once, together with the arena
+    QIviQueryTermArena *owner = arena.take();
+    return QSharedPointer<QIviAbstractQueryTerm>(term, [owner](QIviAbstractQueryTerm *) {
+        delete owner;
+    });
+}
+
+QIviAbstractQueryTerm *QIviQueryParser::parseTerms()
 {
     const int INITIAL_STATE = 0;
 
     int yytoken = -1;
 
     tos = 0;
-    m_offset = 0;
     column = 0;
     state_stack[++tos] = INITIAL_STATE;
     m_termStack.clear();
     m_orderList.clear();
 
-    yyrestart(yyin);
-
     while (true)
     {
         const int state = state_stack.at(tos);
         if (yytoken == -1 && - TERMINAL_COUNT != action_index [state])
-            yytoken = nextToken();
+            yytoken = readToken();
 
         if (yytoken == ERROR) {
-            setErrorString(QString(QLatin1String("Unrecognized token '%1'\n")).arg(QLatin1String(yytext)));
-            qDeleteAll(m_termStack);
+            setErrorString(QString(QLatin1String("Unrecognized token '%1'\n")).arg(tokenText()));
+            deleteTermStack();
             return 0;
         }
 
         if (yytoken == SPACE)
-            yytoken = nextToken();
+            yytoken = readToken();
 
         int act = t_action (state, yytoken);
 
@@ -499,7 +855,7 @@ clause ::= IDENTIFIER number_operator literal ;
               case $rule_number: {
                     if (!checkIdentifier(sym(1).toString()))
                         return 0;
-                    QIviFilterTerm *term = new QIviFilterTerm();
+                    QIviFilterTerm *term = createTerm<QIviFilterTerm, QIviFilterTermPrivate>();
                     term->d_func()->m_property = sym(1).toString();
                     term->d_func()->m_operator = m_operatorStack.pop();
                     term->d_func()->m_value = sym(3);
@@ -511,7 +867,7 @@ clause ::= IDENTIFIER string_operator STRING ;
               case $rule_number: {
                     if (!checkIdentifier(sym(1).toString()))
                         return 0;
-                    QIviFilterTerm *term = new QIviFilterTerm();
+                    QIviFilterTerm *term = createTerm<QIviFilterTerm, QIviFilterTermPrivate>();
                     term->d_func()->m_property = sym(1).toString();
                     term->d_func()->m_operator = m_operatorStack.pop();
                     term->d_func()->m_value = sym(3);
@@ -523,7 +879,7 @@ clause ::= STRING string_operator IDENTIFIER ;
               case $rule_number: {
                     if (!checkIdentifier(sym(3).toString()))
                         return 0;
-                    QIviFilterTerm *term = new QIviFilterTerm();
+                    QIviFilterTerm *term = createTerm<QIviFilterTerm, QIviFilterTermPrivate>();
                     term->d_func()->m_property = sym(3).toString();
                     term->d_func()->m_operator = m_operatorStack.pop();
                     term->d_func()->m_value = sym(1);
@@ -546,7 +902,7 @@ clause ::= literal number_operator IDENTIFIER ;
                         default: qFatal("The Grammer was changed but not all logic was ported properly");
                     }
 
-                    QIviFilterTerm *term = new QIviFilterTerm();
+                    QIviFilterTerm *term = createTerm<QIviFilterTerm, QIviFilterTermPrivate>();
                     term->d_func()->m_property = sym(3).toString();
                     term->d_func()->m_operator = op;
                     term->d_func()->m_value = sym(1);
@@ -641,7 +997,7 @@ multi_operator ::= NE_OP ;
 
             setErrorString(errorMessage);
 
-            qDeleteAll(m_termStack);
+            deleteTermStack();
 
             return 0;
         }
@@ -652,17 +1008,18 @@ multi_operator ::= NE_OP ;
 
 void QIviQueryParser::setErrorString(const QString &error)
 {
-    int err_col = column - yyleng;
+    const int tokenLength = m_arena ? m_tokenLength : yyleng;
+    int err_col = column - tokenLength;
 
     m_error = error;
 
-    m_error.append(m_query).append(QLatin1String("\n"));
+    m_error.append(m_arena ? m_view.toString() : m_query).append(QLatin1String("\n"));
     QString marker(QLatin1String("^"));
 
     for (int i=0; i<err_col; i++)
         marker.prepend(QLatin1String(" "));
 
-    for (int i=0; i<yyleng - 1; i++)
+    for (int i=0; i<tokenLength - 1; i++)
         marker.append(QLatin1String("-"));
 
     m_error.append(marker);
@@ -151,6 +151,16 @@ QIviConjunctionTerm::QIviConjunctionTerm()
 {
 }
 
+/*!
+    \internal
+
+    Used by QIviQueryParser to place the term and \a d in its arena.
+*/
+QIviConjunctionTerm::QIviConjunctionTerm(QIviConjunctionTermPrivate *d)
+    : d_ptr(d)
+{
+}
+
 QIviConjunctionTerm::~QIviConjunctionTerm()
 {
     Q_D(QIviConjunctionTerm);
@@ -212,6 +222,16 @@ QIviScopeTerm::QIviScopeTerm()
 {
 }
 
+/*!
+    \internal
+
+    Used by QIviQueryParser to place the term and \a d in its arena.
+*/
+QIviScopeTerm::QIviScopeTerm(QIviScopeTermPrivate *d)
+    : d_ptr(d)
+{
+}
+
 QIviScopeTerm::~QIviScopeTerm()
 {
     Q_D(QIviScopeTerm);
@@ -302,6 +322,16 @@ QIviFilterTerm::QIviFilterTerm()
 {
 }
 
+/*!
+    \internal
+
+    Used by QIviQueryParser to place the term and \a d in its arena.
+*/
+QIviFilterTerm::QIviFilterTerm(QIviFilterTermPrivate *d)
+    : d_ptr(d)
+{
+}
+
 QIviFilterTerm::~QIviFilterTerm()
 {
     delete d_ptr;
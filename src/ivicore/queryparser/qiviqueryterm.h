@@ -86,6 +86,8 @@ public:
     QList<QIviAbstractQueryTerm*> terms() const;
 
 private:
+    explicit QIviConjunctionTerm(QIviConjunctionTermPrivate *d);
+
     Q_DISABLE_COPY(QIviConjunctionTerm)
     QIviConjunctionTermPrivate * d_ptr;
     Q_DECLARE_PRIVATE(QIviConjunctionTerm)
@@ -108,6 +110,8 @@ public:
     QIviAbstractQueryTerm* term() const;
 
 private:
+    explicit QIviScopeTerm(QIviScopeTermPrivate *d);
+
     Q_DISABLE_COPY(QIviScopeTerm)
     QIviScopeTermPrivate * d_ptr;
     Q_DECLARE_PRIVATE(QIviScopeTerm)
@@ -142,6 +146,8 @@ public:
     bool isNegated() const;
 
 private:
+    explicit QIviFilterTerm(QIviFilterTermPrivate *d);
+
     Q_DISABLE_COPY(QIviFilterTerm)
     QIviFilterTermPrivate * d_ptr;
     Q_DECLARE_PRIVATE(QIviFilterTerm)
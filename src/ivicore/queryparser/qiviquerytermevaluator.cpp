@@ -0,0 +1,573 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#include "qiviquerytermevaluator.h"
+#include "qiviquerytermevaluator_p.h"
+
+#include <QMetaType>
+
+QT_BEGIN_NAMESPACE
+
+template <typename T>
+T QIviQueryTermEvaluatorPrivate::read(const Property &property, const void *gadget)
+{
+    //Same as QMetaProperty::readOnGadget(), but without wrapping the value into a QVariant
+    T value = T();
+    void *argv[] = { &value };
+    property.enclosingMetaObject->d.static_metacall(reinterpret_cast<QObject *>(const_cast<void *>(gadget)),
+                                                     QMetaObject::ReadProperty, property.localIndex, argv);
+    return value;
+}
+
+int QIviQueryTermEvaluatorPrivate::resolveProperty(const QString &name)
+{
+    for (int i = 0; i < m_properties.count(); i++) {
+        if (QLatin1String(m_properties.at(i).property.name()) == name)
+            return i;
+    }
+
+    const int index = m_metaObject->indexOfProperty(name.toLatin1().constData());
+    if (index == -1) {
+        setError(QStringLiteral("%1 doesn't have a property called %2").arg(QLatin1String(m_metaObject->className()), name));
+        return -1;
+    }
+
+    Property property;
+    property.property = m_metaObject->property(index);
+    property.enclosingMetaObject = property.property.enclosingMetaObject();
+    property.localIndex = index - property.enclosingMetaObject->propertyOffset();
+    property.metaType = property.property.userType();
+    property.valueType = Other;
+
+    //Enums and all other types are read using a QVariant
+    if (!property.property.isEnumType() && property.enclosingMetaObject->d.static_metacall) {
+        switch (property.metaType) {
+        case QMetaType::Bool:
+            property.valueType = Bool;
+            break;
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+            property.valueType = Integer;
+            break;
+        case QMetaType::Float:
+        case QMetaType::Double:
+            property.valueType = Double;
+            break;
+        case QMetaType::QString:
+            property.valueType = String;
+            break;
+        default:
+            break;
+        }
+    }
+
+    m_properties.append(property);
+    return m_properties.count() - 1;
+}
+
+bool QIviQueryTermEvaluatorPrivate::compileTerm(const QIviAbstractQueryTerm *term, bool negated)
+{
+    switch (term->type()) {
+    case QIviAbstractQueryTerm::ScopeTerm: {
+        //A scope only groups the terms, its negation is applied to the term it holds
+        const auto *scope = static_cast<const QIviScopeTerm *>(term);
+        return compileTerm(scope->term(), negated != scope->isNegated());
+    }
+    case QIviAbstractQueryTerm::ConjunctionTerm: {
+        const auto *conjunction = static_cast<const QIviConjunctionTerm *>(term);
+        const Node::Kind kind = conjunction->conjunction() == QIviConjunctionTerm::Or ? Node::OrNode : Node::AndNode;
+        const int index = m_nodes.count();
+        m_nodes.append({kind, negated, -1, -1});
+
+        const auto terms = conjunction->terms();
+        for (const QIviAbstractQueryTerm *child : terms) {
+            if (!compileTerm(child, false))
+                return false;
+        }
+        m_nodes[index].end = m_nodes.count();
+        return true;
+    }
+    case QIviAbstractQueryTerm::FilterTerm: {
+        const auto *filterTerm = static_cast<const QIviFilterTerm *>(term);
+        Filter filter;
+        if (!compileFilter(filterTerm, &filter))
+            return false;
+
+        m_filters.append(filter);
+        m_nodes.append({Node::FilterNode, negated != filterTerm->isNegated(), m_filters.count() - 1, m_nodes.count() + 1});
+        return true;
+    }
+    }
+
+    return false;
+}
+
+bool QIviQueryTermEvaluatorPrivate::compileFilter(const QIviFilterTerm *term, Filter *filter)
+{
+    filter->property = resolveProperty(term->propertyName());
+    if (filter->property == -1)
+        return false;
+
+    const Property &property = m_properties.at(filter->property);
+    const QVariant value = term->value();
+    const bool numericValue = value.type() != QVariant::String;
+    const bool floatingValue = value.userType() == QMetaType::Double || value.userType() == QMetaType::Float;
+    filter->operatorType = term->operatorType();
+
+    //Convert the value once to the type used for the comparison with every row
+    bool ok = true;
+    switch (property.valueType) {
+    case Bool:
+        filter->comparison = CompareBool;
+        ok = value.canConvert<bool>();
+        filter->boolValue = value.toBool();
+        break;
+    case Integer:
+        filter->comparison = CompareInteger;
+        if (!floatingValue)
+            filter->integerValue = value.toLongLong(&ok);
+        if (floatingValue || !ok) {
+            filter->comparison = CompareDouble;
+            filter->doubleValue = value.toDouble(&ok);
+        }
+        break;
+    case Double:
+        filter->comparison = CompareDouble;
+        filter->doubleValue = value.toDouble(&ok);
+        break;
+    case String:
+        //Strings are compared as numbers when the query uses a number, e.g. for numerical ids
+        if (numericValue) {
+            filter->comparison = CompareDouble;
+            filter->doubleValue = value.toDouble(&ok);
+            break;
+        }
+        filter->comparison = CompareString;
+        filter->stringValue = value.toString();
+        if (filter->operatorType == QIviFilterTerm::EqualsCaseInsensitive && filter->stringValue.contains(QLatin1Char('*'))) {
+            //The wildcard matches any number of characters, like LIKE does in SQL
+            QStringList parts = filter->stringValue.split(QLatin1Char('*'));
+            for (QString &part : parts)
+                part = QRegularExpression::escape(part);
+            filter->pattern = QRegularExpression(QStringLiteral("\\A") + parts.join(QStringLiteral(".*")) + QStringLiteral("\\z"),
+                                                 QRegularExpression::CaseInsensitiveOption | QRegularExpression::DotMatchesEverythingOption);
+        }
+        break;
+    case Other:
+        filter->comparison = CompareVariant;
+        filter->variantValue = value;
+        filter->stringValue = value.toString();
+        if (numericValue)
+            filter->doubleValue = value.toDouble(&ok);
+        break;
+    }
+
+    if (!ok) {
+        setError(QStringLiteral("The value %1 can't be compared with the property %2").arg(value.toString(), term->propertyName()));
+        return false;
+    }
+    return true;
+}
+
+void QIviQueryTermEvaluatorPrivate::setError(const QString &error)
+{
+    m_error = error;
+    m_nodes.clear();
+    m_filters.clear();
+    m_orders.clear();
+}
+
+bool QIviQueryTermEvaluatorPrivate::evaluate(int index, const void *gadget) const
+{
+    const Node &node = m_nodes.at(index);
+    bool result = false;
+    switch (node.kind) {
+    case Node::FilterNode:
+        result = matchFilter(m_filters.at(node.filter), gadget);
+        break;
+    case Node::AndNode:
+        result = true;
+        for (int child = index + 1; child < node.end && result; child = m_nodes.at(child).end)
+            result = evaluate(child, gadget);
+        break;
+    case Node::OrNode:
+        for (int child = index + 1; child < node.end && !result; child = m_nodes.at(child).end)
+            result = evaluate(child, gadget);
+        break;
+    }
+    return result != node.negated;
+}
+
+bool QIviQueryTermEvaluatorPrivate::matchFilter(const Filter &filter, const void *gadget) const
+{
+    const Property &property = m_properties.at(filter.property);
+    const Qt::CaseSensitivity caseSensitivity = filter.operatorType == QIviFilterTerm::EqualsCaseInsensitive ? Qt::CaseInsensitive : Qt::CaseSensitive;
+
+    int result = 0;
+    switch (filter.comparison) {
+    case CompareBool:
+        result = int(read<bool>(property, gadget)) - int(filter.boolValue);
+        break;
+    case CompareInteger: {
+        const qlonglong value = readInteger(property, gadget);
+        result = value < filter.integerValue ? -1 : (value > filter.integerValue ? 1 : 0);
+        break;
+    }
+    case CompareDouble: {
+        bool ok = true;
+        const double value = readDouble(property, gadget, &ok);
+        if (!ok)
+            return false;
+        result = value < filter.doubleValue ? -1 : (value > filter.doubleValue ? 1 : 0);
+        break;
+    }
+    case CompareString: {
+        const QString value = read<QString>(property, gadget);
+        if (!filter.pattern.pattern().isEmpty())
+            return filter.pattern.match(value).hasMatch();
+        result = value.compare(filter.stringValue, caseSensitivity);
+        break;
+    }
+    case CompareVariant: {
+        const QVariant value = property.property.readOnGadget(gadget);
+        if (filter.variantValue.type() == QVariant::String) {
+            result = value.toString().compare(filter.stringValue, caseSensitivity);
+        } else {
+            bool ok = true;
+            const double number = value.toDouble(&ok);
+            if (!ok)
+                return false;
+            result = number < filter.doubleValue ? -1 : (number > filter.doubleValue ? 1 : 0);
+        }
+        break;
+    }
+    }
+
+    switch (filter.operatorType) {
+    case QIviFilterTerm::Equals:
+    case QIviFilterTerm::EqualsCaseInsensitive: return result == 0;
+    case QIviFilterTerm::Unequals: return result != 0;
+    case QIviFilterTerm::GreaterThan: return result > 0;
+    case QIviFilterTerm::GreaterEquals: return result >= 0;
+    case QIviFilterTerm::LowerThan: return result < 0;
+    case QIviFilterTerm::LowerEquals: return result <= 0;
+    }
+
+    return false;
+}
+
+int QIviQueryTermEvaluatorPrivate::compare(const Property &property, const void *left, const void *right) const
+{
+    switch (property.valueType) {
+    case Bool:
+        return int(read<bool>(property, left)) - int(read<bool>(property, right));
+    case Integer: {
+        const qlonglong leftValue = readInteger(property, left);
+        const qlonglong rightValue = readInteger(property, right);
+        return leftValue < rightValue ? -1 : (leftValue > rightValue ? 1 : 0);
+    }
+    case Double: {
+        bool ok = true;
+        const double leftValue = readDouble(property, left, &ok);
+        const double rightValue = readDouble(property, right, &ok);
+        return leftValue < rightValue ? -1 : (leftValue > rightValue ? 1 : 0);
+    }
+    case String:
+        return read<QString>(property, left).compare(read<QString>(property, right));
+    case Other: {
+        const QVariant leftValue = property.property.readOnGadget(left);
+        const QVariant rightValue = property.property.readOnGadget(right);
+        bool leftOk = false;
+        bool rightOk = false;
+        const double leftNumber = leftValue.toDouble(&leftOk);
+        const double rightNumber = rightValue.toDouble(&rightOk);
+        if (leftOk && rightOk)
+            return leftNumber < rightNumber ? -1 : (leftNumber > rightNumber ? 1 : 0);
+        return leftValue.toString().compare(rightValue.toString());
+    }
+    }
+
+    return 0;
+}
+
+const void *QIviQueryTermEvaluatorPrivate::gadgetFromVariant(const QVariant &item) const
+{
+    if (!m_metaObject || !item.isValid())
+        return nullptr;
+
+    const int userType = item.userType();
+    if (userType == m_metaType)
+        return item.constData();
+
+    //Also accept gadgets derived from the one the evaluator was compiled for
+    if (!QMetaType::typeFlags(userType).testFlag(QMetaType::IsGadget))
+        return nullptr;
+    const QMetaObject *metaObject = QMetaType::metaObjectForType(userType);
+    if (!metaObject || !metaObject->inherits(m_metaObject))
+        return nullptr;
+    return item.constData();
+}
+
+qlonglong QIviQueryTermEvaluatorPrivate::readInteger(const Property &property, const void *gadget)
+{
+    switch (property.metaType) {
+    case QMetaType::Int: return read<int>(property, gadget);
+    case QMetaType::UInt: return read<uint>(property, gadget);
+    case QMetaType::LongLong: return read<qlonglong>(property, gadget);
+    case QMetaType::ULongLong: return qlonglong(read<qulonglong>(property, gadget));
+    }
+
+    return 0;
+}
+
+double QIviQueryTermEvaluatorPrivate::readDouble(const Property &property, const void *gadget, bool *ok)
+{
+    *ok = true;
+    switch (property.valueType) {
+    case Bool: return read<bool>(property, gadget);
+    case Integer: return readInteger(property, gadget);
+    case Double: return property.metaType == QMetaType::Float ? read<float>(property, gadget) : read<double>(property, gadget);
+    case String: return read<QString>(property, gadget).toDouble(ok);
+    case Other: return property.property.readOnGadget(gadget).toDouble(ok);
+    }
+
+    return 0;
+}
+
+/*!
+    \class QIviQueryTermEvaluator
+    \inmodule QtIviCore
+    \brief The QIviQueryTermEvaluator applies a query to gadgets held in memory.
+
+    Backends which don't use a database, can use the QIviQueryTermEvaluator to filter and sort
+    their rows according to the query of a QIviSearchAndBrowseModel. The evaluator compiles the
+    term tree and the order terms for a specific gadget type once: the identifiers are resolved
+    to the properties of the gadget and the values of the query are converted to the type of
+    these properties. Evaluating a row only reads the needed properties and compares them,
+    without any lookups by name.
+
+    \code
+    void MyBackend::setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms)
+    {
+        m_evaluator = QIviQueryTermEvaluator(&QIviAudioTrackItem::staticMetaObject, term, orderTerms);
+        if (!m_evaluator.isValid())
+            qWarning() << m_evaluator.errorString();
+
+        m_rows = m_evaluator.filter(m_allTracks);
+        m_evaluator.sort(m_rows);
+    }
+    \endcode
+
+    The rows can either be gadgets of the type the evaluator was created for, or QVariants holding
+    such a gadget or a gadget derived from it.
+
+    A \c '*' in a string compared using the case-insensitive \c ~= operator matches any number of
+    characters. Properties of type QString are compared as numbers if the query uses a number.
+
+    Once created, the evaluator is never modified and can be used from multiple threads at the
+    same time.
+*/
+
+/*!
+    \fn template <typename T> bool QIviQueryTermEvaluator::matches(const T &gadget) const
+
+    Returns \c true if the \a gadget matches the filter of this evaluator.
+*/
+
+/*!
+    \fn template <typename T> bool QIviQueryTermEvaluator::lessThan(const T &left, const T &right) const
+
+    Returns \c true if the \a left gadget needs to be sorted before the \a right gadget.
+*/
+
+/*!
+    \fn template <typename T> QList<T> QIviQueryTermEvaluator::filter(const QList<T> &rows) const
+
+    Returns all \a rows which match the filter of this evaluator, in their original order.
+*/
+
+/*!
+    \fn template <typename T> void QIviQueryTermEvaluator::sort(QList<T> &rows) const
+
+    Sorts the \a rows according to the order terms of this evaluator. Rows which are equal keep
+    their order.
+*/
+
+/*!
+    Constructs an invalid evaluator, which doesn't match any row.
+*/
+QIviQueryTermEvaluator::QIviQueryTermEvaluator()
+    : d(new QIviQueryTermEvaluatorPrivate)
+{
+}
+
+/*!
+    Constructs an evaluator for gadgets of the type described by \a metaObject, which applies the
+    \a term and the \a orderTerms. The evaluator doesn't keep a reference to the terms.
+
+    If \a term is \c nullptr, all rows match. If the terms can't be applied to the gadget, e.g.
+    because an identifier is not a property of the gadget, the evaluator is invalid.
+
+    \sa isValid(), errorString()
+*/
+QIviQueryTermEvaluator::QIviQueryTermEvaluator(const QMetaObject *metaObject, const QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms)
+    : d(new QIviQueryTermEvaluatorPrivate)
+{
+    d->m_metaObject = metaObject;
+    if (!metaObject) {
+        d->setError(QStringLiteral("No meta object provided"));
+        return;
+    }
+    d->m_metaType = QMetaType::type(metaObject->className());
+
+    if (term && !d->compileTerm(term, false))
+        return;
+
+    for (const QIviOrderTerm &orderTerm : orderTerms) {
+        const int property = d->resolveProperty(orderTerm.propertyName());
+        if (property == -1)
+            return;
+        d->m_orders.append({property, orderTerm.isAscending()});
+    }
+}
+
+QIviQueryTermEvaluator::QIviQueryTermEvaluator(const QIviQueryTermEvaluator &other) = default;
+
+QIviQueryTermEvaluator::~QIviQueryTermEvaluator() = default;
+
+QIviQueryTermEvaluator &QIviQueryTermEvaluator::operator=(const QIviQueryTermEvaluator &other)
+{
+    if (this != &other)
+        d.operator=(other.d);
+    return *this;
+}
+
+/*!
+    Returns \c true if the terms were compiled successfully.
+*/
+bool QIviQueryTermEvaluator::isValid() const
+{
+    return d->m_metaObject && d->m_error.isEmpty();
+}
+
+/*!
+    Returns why the terms couldn't be compiled, or an empty string if the evaluator is valid.
+*/
+QString QIviQueryTermEvaluator::errorString() const
+{
+    return d->m_error;
+}
+
+/*!
+    Returns the meta-object of the gadgets this evaluator was created for.
+*/
+const QMetaObject *QIviQueryTermEvaluator::metaObject() const
+{
+    return d->m_metaObject;
+}
+
+/*!
+    Returns \c true if this evaluator has a filter, which rows need to match.
+*/
+bool QIviQueryTermEvaluator::hasFilter() const
+{
+    return !isValid() || !d->m_nodes.isEmpty();
+}
+
+/*!
+    Returns \c true if this evaluator has order terms to sort the rows.
+*/
+bool QIviQueryTermEvaluator::hasOrder() const
+{
+    return !d->m_orders.isEmpty();
+}
+
+/*!
+    Returns \c true if the \a gadget matches the filter of this evaluator. The \a gadget needs
+    to point to a gadget of the type this evaluator was created for.
+*/
+bool QIviQueryTermEvaluator::matchesGadget(const void *gadget) const
+{
+    if (!isValid() || !gadget)
+        return false;
+
+    return d->m_nodes.isEmpty() || d->evaluate(0, gadget);
+}
+
+/*!
+    Returns \c true if the \a left gadget needs to be sorted before the \a right gadget. Both
+    need to point to gadgets of the type this evaluator was created for.
+*/
+bool QIviQueryTermEvaluator::lessThanGadget(const void *left, const void *right) const
+{
+    if (!isValid() || !left || !right)
+        return false;
+
+    for (const QIviQueryTermEvaluatorPrivate::Order &order : qAsConst(d->m_orders)) {
+        const int result = d->compare(d->m_properties.at(order.property), left, right);
+        if (result)
+            return order.ascending ? result < 0 : result > 0;
+    }
+    return false;
+}
+
+/*!
+    Returns \c true if the gadget held by \a item matches the filter of this evaluator.
+
+    Items which don't hold a gadget of the type this evaluator was created for, never match.
+*/
+bool QIviQueryTermEvaluator::matches(const QVariant &item) const
+{
+    return matchesGadget(d->gadgetFromVariant(item));
+}
+
+/*!
+    Returns \c true if the gadget held by \a left needs to be sorted before the gadget held by
+    \a right.
+*/
+bool QIviQueryTermEvaluator::lessThan(const QVariant &left, const QVariant &right) const
+{
+    return lessThanGadget(d->gadgetFromVariant(left), d->gadgetFromVariant(right));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+
+#ifndef QIVIQUERYTERMEVALUATOR_H
+#define QIVIQUERYTERMEVALUATOR_H
+
+#include <QtCore/QList>
+#include <QtCore/QSharedDataPointer>
+#include <QtCore/QVariant>
+#include <QtIviCore/qiviqueryterm.h>
+#include <QtIviCore/qtiviglobal.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+class QIviQueryTermEvaluatorPrivate;
+
+class Q_QTIVICORE_EXPORT QIviQueryTermEvaluator
+{
+public:
+    QIviQueryTermEvaluator();
+    QIviQueryTermEvaluator(const QMetaObject *metaObject, const QIviAbstractQueryTerm *term,
+                           const QList<QIviOrderTerm> &orderTerms = QList<QIviOrderTerm>());
+    QIviQueryTermEvaluator(const QIviQueryTermEvaluator &other);
+    ~QIviQueryTermEvaluator();
+    QIviQueryTermEvaluator &operator=(const QIviQueryTermEvaluator &other);
+
+    bool isValid() const;
+    QString errorString() const;
+    const QMetaObject *metaObject() const;
+    bool hasFilter() const;
+    bool hasOrder() const;
+
+    bool matchesGadget(const void *gadget) const;
+    bool lessThanGadget(const void *left, const void *right) const;
+
+    bool matches(const QVariant &item) const;
+    bool lessThan(const QVariant &left, const QVariant &right) const;
+
+    template <typename T> bool matches(const T &gadget) const
+    {
+        return matchesGadget(&gadget);
+    }
+
+    template <typename T> bool lessThan(const T &left, const T &right) const
+    {
+        return lessThanGadget(&left, &right);
+    }
+
+    template <typename T> QList<T> filter(const QList<T> &rows) const
+    {
+        if (!hasFilter())
+            return rows;
+
+        QList<T> result;
+        for (const T &row : rows) {
+            if (matches(row))
+                result.append(row);
+        }
+        return result;
+    }
+
+    template <typename T> void sort(QList<T> &rows) const
+    {
+        if (!hasOrder())
+            return;
+
+        std::stable_sort(rows.begin(), rows.end(), [this](const T &left, const T &right) {
+            return lessThan(left, right);
+        });
+    }
+
+private:
+    QSharedDataPointer<QIviQueryTermEvaluatorPrivate> d;
+};
+
+Q_DECLARE_TYPEINFO(QIviQueryTermEvaluator, Q_MOVABLE_TYPE);
+
+QT_END_NAMESPACE
+
+#endif // QIVIQUERYTERMEVALUATOR_H
@@ -0,0 +1,153 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#ifndef QIVIQUERYTERMEVALUATOR_P_H
+#define QIVIQUERYTERMEVALUATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail. This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qiviquerytermevaluator.h"
+
+#include <QMetaProperty>
+#include <QRegularExpression>
+#include <QVector>
+
+QT_BEGIN_NAMESPACE
+
+class QIviQueryTermEvaluatorPrivate : public QSharedData
+{
+public:
+    enum ValueType {
+        Bool,
+        Integer,
+        Double,
+        String,
+        Other
+    };
+
+    enum Comparison {
+        CompareBool,
+        CompareInteger,
+        CompareDouble,
+        CompareString,
+        CompareVariant
+    };
+
+    //A property of the gadget, which is read directly using the static metacall of the class
+    //declaring it
+    struct Property {
+        QMetaProperty property;
+        const QMetaObject *enclosingMetaObject;
+        int localIndex;
+        int metaType;
+        ValueType valueType;
+    };
+
+    //A filter with the value already converted to the type used for the comparison
+    struct Filter {
+        int property = -1;
+        QIviFilterTerm::Operator operatorType = QIviFilterTerm::Equals;
+        Comparison comparison = CompareVariant;
+        bool boolValue = false;
+        qlonglong integerValue = 0;
+        double doubleValue = 0;
+        QString stringValue;
+        QVariant variantValue;
+        QRegularExpression pattern;
+    };
+
+    //The term tree is stored in pre-order. Every node knows where its subtree ends, which makes it
+    //possible to skip the remaining children once the result of a conjunction is known.
+    struct Node {
+        enum Kind {
+            FilterNode,
+            AndNode,
+            OrNode
+        };
+        Kind kind;
+        bool negated;
+        int filter;
+        int end;
+    };
+
+    struct Order {
+        int property;
+        bool ascending;
+    };
+
+    QIviQueryTermEvaluatorPrivate() = default;
+    QIviQueryTermEvaluatorPrivate(const QIviQueryTermEvaluatorPrivate &other) = default;
+
+    int resolveProperty(const QString &name);
+    bool compileTerm(const QIviAbstractQueryTerm *term, bool negated);
+    bool compileFilter(const QIviFilterTerm *term, Filter *filter);
+    void setError(const QString &error);
+
+    bool evaluate(int node, const void *gadget) const;
+    bool matchFilter(const Filter &filter, const void *gadget) const;
+    int compare(const Property &property, const void *left, const void *right) const;
+    const void *gadgetFromVariant(const QVariant &item) const;
+
+    template <typename T> static T read(const Property &property, const void *gadget);
+    static qlonglong readInteger(const Property &property, const void *gadget);
+    static double readDouble(const Property &property, const void *gadget, bool *ok);
+
+    const QMetaObject *m_metaObject = nullptr;
+    int m_metaType = QMetaType::UnknownType;
+    QVector<Property> m_properties;
+    QVector<Filter> m_filters;
+    QVector<Node> m_nodes;
+    QVector<Order> m_orders;
+    QString m_error;
+};
+
+QT_END_NAMESPACE
+
+#endif // QIVIQUERYTERMEVALUATOR_P_H
@@ -29,7 +29,10 @@ enable-qlalr {
 
 HEADERS += \
     $$PWD/qiviqueryterm.h \
-    $$PWD/qiviqueryterm_p.h
+    $$PWD/qiviqueryterm_p.h \
+    $$PWD/qiviquerytermevaluator.h \
+    $$PWD/qiviquerytermevaluator_p.h
 
 SOURCES += \
-    $$PWD/qiviqueryterm.cpp
+    $$PWD/qiviqueryterm.cpp \
+    $$PWD/qiviquerytermevaluator.cpp
@@ -66,7 +66,9 @@ QIviMediaPlayerPrivate::QIviMediaPlayerPrivate(const QString &interface, QIviMed
 {
     qRegisterMetaType<QIviPlayQueue*>();
     qRegisterMetaType<QIviPlayableItem>();
+    qRegisterMetaTypeStreamOperators<QIviPlayableItem>();
     qRegisterMetaType<QIviAudioTrackItem>();
+    qRegisterMetaTypeStreamOperators<QIviAudioTrackItem>();
 }
 
 void QIviMediaPlayerPrivate::initialize()
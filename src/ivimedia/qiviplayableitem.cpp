@@ -468,6 +468,28 @@ bool QIviAudioTrackItem::operator==(const QIviAudioTrackItem &other)
             d->m_rating == other.d->m_rating);
 }
 
+QDataStream &operator<<(QDataStream &stream, const QIviPlayableItem &obj)
+{
+    stream << obj.id();
+    stream << obj.url();
+    stream << QVariant(obj.data());
+    return stream;
+}
+
+QDataStream &operator>>(QDataStream &stream, QIviPlayableItem &obj)
+{
+    QString id;
+    QUrl url;
+    QVariant data;
+    stream >> id;
+    stream >> url;
+    stream >> data;
+    obj.setId(id);
+    obj.setUrl(url);
+    obj.setData(data.toMap());
+    return stream;
+}
+
 QDataStream &operator<<(QDataStream &stream, const QIviAudioTrackItem &obj)
 {
     stream << obj.id();
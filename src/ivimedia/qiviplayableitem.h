@@ -126,6 +126,8 @@ private:
 };
 Q_DECLARE_TYPEINFO(QIviAudioTrackItem, Q_MOVABLE_TYPE);
 
+Q_QTIVIMEDIA_EXPORT QDataStream &operator<<(QDataStream &stream, const QIviPlayableItem &obj);
+Q_QTIVIMEDIA_EXPORT QDataStream &operator>>(QDataStream &stream, QIviPlayableItem &obj);
 Q_QTIVIMEDIA_EXPORT QDataStream &operator<<(QDataStream &stream, const QIviAudioTrackItem &obj);
 Q_QTIVIMEDIA_EXPORT QDataStream &operator>>(QDataStream &stream, QIviAudioTrackItem &obj);
 
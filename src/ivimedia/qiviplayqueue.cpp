@@ -56,6 +56,11 @@ QIviPlayQueuePrivate::QIviPlayQueuePrivate(QIviMediaPlayer *player, QIviPlayQueu
     , m_identifier(QUuid::createUuid())
     , m_currentIndex(-1)
     , m_chunkSize(30)
+    , m_chunkCache(&m_itemList, &m_chunkSize, [this](int chunkIndex, int start, int end) {
+        Q_UNUSED(chunkIndex)
+        for (int i = start; i < end; i++)
+            m_itemList[i] = QVariant();
+    })
     , m_moreAvailable(false)
     , m_fetchMoreThreshold(10)
     , m_fetchedDataCount(0)
@@ -110,29 +115,49 @@ void QIviPlayQueuePrivate::onDataFetched(const QUuid &identifier, const QList<QV
     if (m_identifier != identifier)
         return;
 
-    if (!items.count())
+    //The chunk was marked as available when it was requested, it needs to be requested again on the
+    //next access if its rows don't arrive
+    const int chunkIndex = start / m_chunkSize;
+    auto dropChunk = [this, chunkIndex]() {
+        if (chunkIndex < m_chunkCache.chunkCount())
+            m_chunkCache.setChunkAvailable(chunkIndex, false);
+    };
+
+    if (!items.count()) {
+        dropChunk();
         return;
+    }
 
     Q_Q(QIviPlayQueue);
-    m_moreAvailable = moreAvailable;
 
-    if (m_loadingType == QIviPlayQueue::FetchMore) {
+    if (m_loadingType == QIviPlayQueue::FetchMore && start >= m_itemList.count()) {
+        m_moreAvailable = moreAvailable;
         q->beginInsertRows(QModelIndex(), m_itemList.count(), m_itemList.count() + items.count() -1);
-        m_itemList += items;
+        m_itemList += items.toVector();
         m_fetchedDataCount = m_itemList.count();
         q->endInsertRows();
+
+        m_chunkCache.resize((m_itemList.count() + m_chunkSize - 1) / m_chunkSize);
     } else {
+        //Either the DataChanged mode or a chunk which got evicted from the cache has been fetched again
         if (m_itemList.count() < start + items.count()) {
             qWarning() << "countChanged signal needs to be emitted before the dataFetched signal";
+            dropChunk();
             return;
         }
 
-        m_fetchedDataCount = start + items.count();
+        if (m_loadingType == QIviPlayQueue::DataChanged) {
+            m_moreAvailable = moreAvailable;
+            m_fetchedDataCount = start + items.count();
+        }
 
         for (int i = 0; i < items.count(); i++)
             m_itemList.replace(start + i, items.at(i));
         emit q->dataChanged(q->index(start), q->index(start + items.count() -1));
     }
+
+    m_chunkCache.setChunkAvailable(chunkIndex);
+    m_chunkCache.cacheChunk(chunkIndex);
 }
 
 void QIviPlayQueuePrivate::onCountChanged(int new_length)
@@ -141,10 +166,21 @@ void QIviPlayQueuePrivate::onCountChanged(int new_length)
         return;
 
     Q_Q(QIviPlayQueue);
-    q->beginInsertRows(QModelIndex(), m_itemList.count(), m_itemList.count() + new_length -1);
-    for (int i = 0; i < new_length; i++)
-        m_itemList.append(QVariant());
-    q->endInsertRows();
+    const int oldLength = m_itemList.count();
+    if (new_length > oldLength) {
+        //Only placeholders are created, the data of a chunk is fetched once it is needed
+        q->beginInsertRows(QModelIndex(), oldLength, new_length -1);
+        m_itemList.insert(oldLength, new_length - oldLength, QVariant());
+        q->endInsertRows();
+
+        m_chunkCache.resize((new_length + m_chunkSize - 1) / m_chunkSize);
+    } else {
+        q->beginRemoveRows(QModelIndex(), new_length, oldLength -1);
+        m_itemList.remove(new_length, oldLength - new_length);
+        q->endRemoveRows();
+
+        m_chunkCache.updateAvailability(new_length);
+    }
 }
 
 void QIviPlayQueuePrivate::onDataChanged(const QList<QVariant> &data, int start, int count)
@@ -161,15 +197,48 @@ void QIviPlayQueuePrivate::onDataChanged(const QList<QVariant> &data, int start,
 
     Q_Q(QIviPlayQueue);
 
-    //delta > 0 insert rows
-    //delta < 0 remove rows
-    int delta = data.count() - count;
+    //Backends report a moved item by updating the range between the old and the new position
+    if (data.count() == count) {
+        QStringList oldIds;
+        QStringList newIds;
+        for (int i = 0; i < count; i++) {
+            const QIviPlayableItem *oldItem = itemAt(start + i);
+            oldIds.append(oldItem ? oldItem->id() : QString());
+            const QIviPlayableItem *newItem = qtivi_gadgetFromVariant<QIviPlayableItem>(q, data.at(i));
+            newIds.append(newItem ? newItem->id() : QString());
+        }
+
+        int from = -1;
+        int to = -1;
+        if (qtivi_findMovedRow(oldIds, newIds, &from, &to)) {
+            q->beginMoveRows(QModelIndex(), start + from, start + from, QModelIndex(), start + (to > from ? to + 1 : to));
+            m_itemList.move(start + from, start + to);
+            q->endMoveRows();
+
+            //The content of the rows might have changed together with their position
+            int firstChanged = -1;
+            int lastChanged = -1;
+            for (int i = 0; i < count; i++) {
+                if (isSameItem(start + i, data.at(i)))
+                    continue;
+                m_itemList.replace(start + i, data.at(i));
+                if (firstChanged == -1)
+                    firstChanged = i;
+                lastChanged = i;
+            }
+            if (firstChanged != -1)
+                emit q->dataChanged(q->index(start + firstChanged), q->index(start + lastChanged));
+
+            m_chunkCache.updateAvailability(start);
+            return;
+        }
+    }
+
     //find data overlap for updates
-    int updateCount = qMin(data.count(), count);
-    int updateCountEnd = updateCount > 0 ? updateCount + 1 : 0;
+    const int updateCount = qMin(data.count(), count);
     //range which is either added or removed
-    int insertRemoveStart = start + updateCountEnd;
-    int insertRemoveCount = qMax(data.count(), count) - updateCount;
+    const int spliceStart = start + updateCount;
+    const int delta = data.count() - count;
 
     if (updateCount > 0) {
         for (int i = start, j=0; j < updateCount; i++, j++)
@@ -177,17 +246,25 @@ void QIviPlayQueuePrivate::onDataChanged(const QList<QVariant> &data, int start,
         emit q->dataChanged(q->index(start), q->index(start + updateCount -1));
     }
 
+    if (delta == 0)
+        return;
+
     if (delta < 0) { //Remove
-        q->beginRemoveRows(QModelIndex(), insertRemoveStart, insertRemoveStart + insertRemoveCount -1);
-        for (int i = insertRemoveStart; i < insertRemoveStart + insertRemoveCount; i++)
-            m_itemList.removeAt(i);
+        q->beginRemoveRows(QModelIndex(), spliceStart, spliceStart - delta -1);
+        m_itemList.remove(spliceStart, -delta);
         q->endRemoveRows();
-    } else if (delta > 0) { //Insert
-        q->beginInsertRows(QModelIndex(), insertRemoveStart, insertRemoveStart + insertRemoveCount -1);
-        for (int i = insertRemoveStart, j = updateCountEnd; i < insertRemoveStart + insertRemoveCount; i++, j++)
-            m_itemList.insert(i, data.at(j));
+    } else { //Insert
+        q->beginInsertRows(QModelIndex(), spliceStart, spliceStart + delta -1);
+        m_itemList.insert(spliceStart, delta, QVariant());
+        for (int i = 0; i < delta; i++)
+            m_itemList[spliceStart + i] = data.at(updateCount + i);
         q->endInsertRows();
     }
+
+    if (m_fetchedDataCount > spliceStart)
+        m_fetchedDataCount = qMax(spliceStart, m_fetchedDataCount + delta);
+
+    m_chunkCache.updateAvailability(spliceStart);
 }
 
 void QIviPlayQueuePrivate::onFetchMoreThresholdReached()
@@ -201,10 +278,12 @@ void QIviPlayQueuePrivate::resetModel()
     Q_Q(QIviPlayQueue);
     q->beginResetModel();
     m_itemList.clear();
+    m_chunkCache.clear();
     q->endResetModel();
     m_fetchedDataCount = 0;
 
-    m_moreAvailable = false;
+    //Setting this to true to let fetchMore do one first fetchcall.
+    m_moreAvailable = true;
     q->fetchMore(QModelIndex());
 }
 
@@ -219,6 +298,8 @@ void QIviPlayQueuePrivate::clearToDefaults()
     m_moreAvailable = false;
     m_fetchMoreThreshold = 10;
     emit q->fetchMoreThresholdChanged(m_fetchMoreThreshold);
+    m_chunkCache.setCacheLimit(0);
+    emit q->cacheLimitChanged(0);
     m_loadingType = QIviPlayQueue::FetchMore;
     emit q->loadingTypeChanged(m_loadingType);
 
@@ -227,13 +308,50 @@ void QIviPlayQueuePrivate::clearToDefaults()
 
 const QIviPlayableItem *QIviPlayQueuePrivate::itemAt(int i) const
 {
-    QVariant var = m_itemList.at(i);
+    const QVariant &var = m_itemList.at(i);
     if (!var.isValid())
         return nullptr;
 
     return qtivi_gadgetFromVariant<QIviPlayableItem>(q_ptr, var);
 }
 
+bool QIviPlayQueuePrivate::isSameItem(int row, const QVariant &item) const
+{
+    const QVariant &oldVar = m_itemList.at(row);
+    if (!oldVar.isValid() || !item.isValid() || oldVar.userType() != item.userType())
+        return false;
+
+    //Gadgets are usually not comparable, the id, url and data identify the content of an item instead
+    const QIviPlayableItem *oldItem = itemAt(row);
+    const QIviPlayableItem *newItem = qtivi_gadgetFromVariant<QIviPlayableItem>(q_ptr, item);
+    if (!oldItem || !newItem)
+        return false;
+
+    return oldItem->id() == newItem->id()
+            && oldItem->name() == newItem->name()
+            && oldItem->type() == newItem->type()
+            && oldItem->url() == newItem->url()
+            && oldItem->data() == newItem->data();
+}
+
+void QIviPlayQueuePrivate::fetchData(int startIndex)
+{
+    if (!playerBackend())
+        return;
+
+    const int start = startIndex >= 0 ? startIndex : m_fetchedDataCount;
+    //Fetching a chunk which got evicted from the cache doesn't change whether more data is available
+    if (m_loadingType == QIviPlayQueue::DataChanged || start >= m_itemList.count())
+        m_moreAvailable = false;
+    //Mark the chunk as available to not request it again while it is on its way. The rows might
+    //not exist yet, as the backend reports the count together with the first chunk.
+    const int chunkIndex = start / m_chunkSize;
+    if (chunkIndex >= m_chunkCache.chunkCount())
+        m_chunkCache.resize(chunkIndex + 1);
+    m_chunkCache.setChunkAvailable(chunkIndex);
+    playerBackend()->fetchData(m_identifier, start, m_chunkSize - start % m_chunkSize);
+}
+
 QIviMediaPlayerBackendInterface *QIviPlayQueuePrivate::playerBackend() const
 {
     return m_player->d_func()->playerBackend();
@@ -379,6 +497,8 @@ void QIviPlayQueue::setChunkSize(int chunkSize)
 
     d->m_chunkSize = chunkSize;
     emit chunkSizeChanged(chunkSize);
+
+    d->m_chunkCache.rebuild();
 }
 
 /*!
@@ -422,6 +542,45 @@ void QIviPlayQueue::setFetchMoreThreshold(int fetchMoreThreshold)
     emit fetchMoreThresholdChanged(fetchMoreThreshold);
 }
 
+/*!
+    \qmlproperty int PlayQueue::cacheLimit
+    \brief Holds the maximum number of chunks which are kept in memory.
+
+    Once more chunks than the limit have been fetched, the least recently used chunks are removed
+    from the cache. The rows of a removed chunk stay in the play queue, but their data is fetched
+    again from the backend the next time it is needed.
+
+    The limit should be bigger than the number of chunks which are visible at the same time.
+    The default value is 0, which means that all fetched chunks are kept in memory.
+*/
+
+/*!
+    \property QIviPlayQueue::cacheLimit
+    \brief Holds the maximum number of chunks which are kept in memory.
+
+    Once more chunks than the limit have been fetched, the least recently used chunks are removed
+    from the cache. The rows of a removed chunk stay in the play queue, but their data is fetched
+    again from the backend the next time it is needed.
+
+    The limit should be bigger than the number of chunks which are visible at the same time.
+    The default value is 0, which means that all fetched chunks are kept in memory.
+*/
+int QIviPlayQueue::cacheLimit() const
+{
+    Q_D(const QIviPlayQueue);
+    return d->m_chunkCache.cacheLimit();
+}
+
+void QIviPlayQueue::setCacheLimit(int cacheLimit)
+{
+    Q_D(QIviPlayQueue);
+    if (d->m_chunkCache.cacheLimit() == cacheLimit)
+        return;
+
+    d->m_chunkCache.setCacheLimit(cacheLimit);
+    emit cacheLimitChanged(cacheLimit);
+}
+
 /*!
     \qmlproperty enumeration PlayQueue::loadingType
     \brief Holds the currently used loading type used for loading the data.
@@ -489,6 +648,14 @@ QVariant QIviPlayQueue::data(const QModelIndex &index, int role) const
     if (row >= d->m_itemList.count() || row < 0)
         return QVariant();
 
+    const int chunkIndex = row / d->m_chunkSize;
+    //The chunk was either never fetched (DataChanged) or got evicted from the cache
+    if (d->m_chunkCache.isChunkMissing(chunkIndex)) {
+        const_cast<QIviPlayQueuePrivate*>(d)->fetchData(chunkIndex * d->m_chunkSize);
+        return QVariant();
+    }
+    d->m_chunkCache.touchChunk(chunkIndex);
+
     if (row >= d->m_fetchedDataCount - d->m_fetchMoreThreshold && canFetchMore(QModelIndex()))
         emit fetchMoreThresholdReached();
 
@@ -609,11 +776,11 @@ void QIviPlayQueue::fetchMore(const QModelIndex &parent)
     if (parent.isValid())
         return;
 
-    if (!d->playerBackend())
+    if (!d->playerBackend() || !d->m_moreAvailable)
         return;
 
     d->m_moreAvailable = false;
-    d->playerBackend()->fetchData(d->m_identifier, d->m_fetchedDataCount, d->m_chunkSize);
+    d->fetchData(-1);
 }
 
 /*!
@@ -58,6 +58,7 @@ class Q_QTIVIMEDIA_EXPORT QIviPlayQueue : public QAbstractListModel
     Q_PROPERTY(int currentIndex READ currentIndex WRITE setCurrentIndex NOTIFY currentIndexChanged)
     Q_PROPERTY(int chunkSize READ chunkSize WRITE setChunkSize NOTIFY chunkSizeChanged)
     Q_PROPERTY(int fetchMoreThreshold READ fetchMoreThreshold WRITE setFetchMoreThreshold NOTIFY fetchMoreThresholdChanged)
+    Q_PROPERTY(int cacheLimit READ cacheLimit WRITE setCacheLimit NOTIFY cacheLimitChanged)
     Q_PROPERTY(int count READ rowCount NOTIFY countChanged)
 
     //TODO fix naming
@@ -87,6 +88,9 @@ public:
     int fetchMoreThreshold() const;
     void setFetchMoreThreshold(int fetchMoreThreshold);
 
+    int cacheLimit() const;
+    void setCacheLimit(int cacheLimit);
+
     QIviPlayQueue::LoadingType loadingType() const;
     void setLoadingType(QIviPlayQueue::LoadingType loadingType);
 
@@ -113,6 +117,7 @@ Q_SIGNALS:
     void countChanged();
     void fetchMoreThresholdChanged(int fetchMoreThreshold);
     void fetchMoreThresholdReached() const;
+    void cacheLimitChanged(int cacheLimit);
     void loadingTypeChanged(QIviPlayQueue::LoadingType loadingType);
 
     void currentIndexChanged(int currentIndex);
@@ -56,11 +56,15 @@
 
 #include "private/qtivimediaglobal_p.h"
 #include "private/qabstractitemmodel_p.h"
+#include "private/qivichunkcache_p.h"
+#include "private/qiviutils_p.h"
 
 #include "qiviplayqueue.h"
 #include "qiviplayableitem.h"
 #include "qivimediaplayer_p.h"
 
+#include <QVector>
+
 QT_BEGIN_NAMESPACE
 
 class Q_QTIVIMEDIA_EXPORT QIviPlayQueuePrivate : public QAbstractItemModelPrivate
@@ -80,6 +84,8 @@ public:
     void resetModel();
     void clearToDefaults();
     const QIviPlayableItem *itemAt(int i) const;
+    bool isSameItem(int row, const QVariant &item) const;
+    void fetchData(int startIndex);
 
     QIviMediaPlayerBackendInterface *playerBackend() const;
 
@@ -90,7 +96,8 @@ public:
     QUuid m_identifier;
     int m_currentIndex;
     int m_chunkSize;
-    QList<QVariant> m_itemList;
+    QVector<QVariant> m_itemList;
+    QIviChunkCache m_chunkCache;
     bool m_moreAvailable;
     int m_fetchMoreThreshold;
     int m_fetchedDataCount;
@@ -53,6 +53,7 @@
 #include <QCoreApplication>
 
 #include "logging.h"
+#include "sqlconnectionpool.h"
 
 QString mediaDatabaseFile()
 {
@@ -84,13 +85,57 @@ QSqlDatabase createDatabaseConnection(const QString &connectionName, const QStri
     db.setDatabaseName(dbFile);
     if (!db.open())
         qFatal("Couldn't couldn't open database: %s", qPrintable(db.lastError().text()));
+    SqlConnectionPool::configure(db);
     return db;
 }
 
+//Creates a full-text index of the text columns of the track table, which is kept in sync with it
+//by triggers and used for the case-insensitive filters. The trigram tokenizer matches any part of
+//a text, but needs SQLite 3.34 or newer. Without it the filters scan the whole track table.
+void createFullTextIndex(QSqlDatabase &db)
+{
+    QSqlQuery query(db);
+    if (query.exec(QStringLiteral("SELECT count() FROM sqlite_master WHERE name = 'track_fts'")) && query.next() && query.value(0).toInt() > 0)
+        return;
+    query.finish();
+
+    const QString columns = QStringLiteral("trackName, albumName, artistName, genre");
+    const QString newValues = QStringLiteral("new.id, new.trackName, new.albumName, new.artistName, new.genre");
+    const QString oldValues = QStringLiteral("'delete', old.id, old.trackName, old.albumName, old.artistName, old.genre");
+    const QStringList statements = {
+        QStringLiteral("CREATE VIRTUAL TABLE track_fts USING fts5(%1, content='track', content_rowid='id', tokenize='trigram')").arg(columns),
+        QStringLiteral("CREATE TRIGGER track_fts_insert AFTER INSERT ON track BEGIN "
+                       "INSERT INTO track_fts(rowid, %1) VALUES (%2); END").arg(columns, newValues),
+        QStringLiteral("CREATE TRIGGER track_fts_delete AFTER DELETE ON track BEGIN "
+                       "INSERT INTO track_fts(track_fts, rowid, %1) VALUES (%2); END").arg(columns, oldValues),
+        QStringLiteral("CREATE TRIGGER track_fts_update AFTER UPDATE ON track BEGIN "
+                       "INSERT INTO track_fts(track_fts, rowid, %1) VALUES (%2); "
+                       "INSERT INTO track_fts(rowid, %1) VALUES (%3); END").arg(columns, oldValues, newValues),
+        //Indexes the tracks which were added before the index existed
+        QStringLiteral("INSERT INTO track_fts(track_fts) VALUES ('rebuild')")
+    };
+
+    db.transaction();
+    for (const QString &statement : statements) {
+        if (!query.exec(statement)) {
+            qCInfo(media) << "The full-text index is not available:" << query.lastError().text();
+            db.rollback();
+            return;
+        }
+    }
+    db.commit();
+}
+
 void createMediaDatabase(const QString &dbFile)
 {
     QSqlDatabase db = createDatabaseConnection(QStringLiteral("main"), dbFile);
-    QSqlQuery query = db.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS \"queue\" (\"id\" INTEGER PRIMARY KEY, \"qindex\" INTEGER, \"track_index\" INTEGER)"));
+
+    //The write-ahead log is stored in the database and lets all connections read while the indexer writes
+    QSqlQuery query = db.exec(QStringLiteral("PRAGMA journal_mode = WAL"));
+    if (query.lastError().isValid())
+        qCWarning(media) << "Couldn't enable the write-ahead log:" << query.lastError().text();
+
+    query = db.exec(QStringLiteral("CREATE TABLE IF NOT EXISTS \"queue\" (\"id\" INTEGER PRIMARY KEY, \"qindex\" INTEGER, \"track_index\" INTEGER)"));
     if (query.lastError().isValid())
         qFatal("Couldn't create Database Tables: %s", qPrintable(query.lastError().text()));
 
@@ -108,6 +153,8 @@ void createMediaDatabase(const QString &dbFile)
     if (query.lastError().isValid())
         qFatal("Couldn't create Database Tables: %s", qPrintable(query.lastError().text()));
     db.commit();
+
+    createFullTextIndex(db);
 }
 
 #endif // DATABASE_HELPER_H
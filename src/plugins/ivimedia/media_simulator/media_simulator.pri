@@ -17,7 +17,9 @@ HEADERS += \
     $$PWD/usbbrowsebackend.h \
     $$PWD/mediaindexerbackend.h \
     $$PWD/logging.h \
-    $$PWD/database_helper.h
+    $$PWD/database_helper.h \
+    $$PWD/sqlconnectionpool.h \
+    $$PWD/sqlstatement.h
 
 SOURCES += \
     $$PWD/mediaplayerbackend.cpp \
@@ -26,4 +28,6 @@ SOURCES += \
     $$PWD/usbdevice.cpp \
     $$PWD/usbbrowsebackend.cpp \
     $$PWD/mediaindexerbackend.cpp \
-    $$PWD/logging.cpp
+    $$PWD/logging.cpp \
+    $$PWD/sqlconnectionpool.cpp \
+    $$PWD/sqlstatement.cpp
@@ -303,6 +303,9 @@ bool MediaIndexerBackend::scanWorker(const ScanData &scanData)
 
 void MediaIndexerBackend::onScanFinished()
 {
+    //Even a failed scan might have changed parts of the content
+    emit contentChanged();
+
     if (!m_folderQueue.isEmpty()) {
         scanNext();
         return;
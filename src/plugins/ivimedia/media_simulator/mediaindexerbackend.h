@@ -69,6 +69,7 @@ public:
 
 signals:
     void indexingDone();
+    void contentChanged();
     void removeFromQueue(int index);
 
 public slots:
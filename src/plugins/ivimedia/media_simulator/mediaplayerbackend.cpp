@@ -61,6 +61,7 @@ MediaPlayerBackend::MediaPlayerBackend(const QSqlDatabase &database, QObject *pa
     , m_state(QIviMediaPlayer::Stopped)
     , m_threadPool(new QThreadPool(this))
     , m_player(new QMediaPlayer(this))
+    , m_connections(database)
 {
     qRegisterMetaType<QIviAudioTrackItem>();
     qRegisterMetaTypeStreamOperators<QIviAudioTrackItem>();
@@ -81,8 +82,12 @@ MediaPlayerBackend::MediaPlayerBackend(const QSqlDatabase &database, QObject *pa
     connect(this, &MediaPlayerBackend::playTrack,
             this, &MediaPlayerBackend::onPlayTrack,
             Qt::QueuedConnection);
+}
 
-    m_db = database;
+MediaPlayerBackend::~MediaPlayerBackend()
+{
+    //The connection is closed by the thread, which needs to be done before the pool is destroyed
+    delete m_threadPool;
 }
 
 void MediaPlayerBackend::initialize()
@@ -166,16 +171,14 @@ void MediaPlayerBackend::setPosition(qint64 position)
 
 void MediaPlayerBackend::fetchData(const QUuid &identifier, int start, int count)
 {
-    QString queryString = QStringLiteral("SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id ORDER BY queue.qindex LIMIT %4, %5")
-            .arg(start)
-            .arg(count);
+    QVector<SqlStatement> statements;
+    statements.append({QStringLiteral("SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id ORDER BY queue.qindex LIMIT ?, ?"),
+                       {start, count}});
 
-    QStringList queries;
-    queries.append(queryString);
     QtConcurrent::run(m_threadPool, this,
                       &MediaPlayerBackend::doSqlOperation,
                       MediaPlayerBackend::Select,
-                      queries,
+                      statements,
                       identifier,
                       start,
                       count);
@@ -186,51 +189,51 @@ void MediaPlayerBackend::insert(int index, const QVariant &i)
     const QIviPlayableItem *item = qtivi_gadgetFromVariant<QIviPlayableItem>(this, i);
     if (!item)
         return;
-    QString queryString;
+    //The names are bound to the statements, as they might contain quotes
+    QVector<SqlStatement> statements;
     if (item->type() == QStringLiteral("audiotrack")) {
         int track_index = item->id().toInt();
-        queryString = QStringLiteral("UPDATE queue SET qindex = qindex + 1 WHERE qindex >= %1;"
-                                     "INSERT INTO queue(qindex, track_index) VALUES( %1, %2);"
-                                     "SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id WHERE qindex=%1")
-                .arg(index)
-                .arg(track_index);
+        statements.append({QStringLiteral("UPDATE queue SET qindex = qindex + 1 WHERE qindex >= ?"), {index}});
+        statements.append({QStringLiteral("INSERT INTO queue(qindex, track_index) VALUES(?, ?)"), {index, track_index}});
+        statements.append({QStringLiteral("SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id WHERE qindex=?"),
+                           {index}});
     } else {
         QString whereClause;
         if (item->type() == QStringLiteral("artist")) {
-            whereClause = QStringLiteral("artistName == \"%1\"").arg(item->name());
+            whereClause = QStringLiteral("artistName = ?");
         } else if (item->type() == QStringLiteral("album")) {
-            whereClause = QStringLiteral("albumName == \"%1\"").arg(item->name());
+            whereClause = QStringLiteral("albumName = ?");
         } else {
             qCWarning(media) << "Can't insert item: The provided type is not supported: " << item->type();
             emit errorChanged(QIviAbstractFeature::InvalidOperation, QStringLiteral("Can't insert item: Given type is not supported."));
             return;
         }
-        queryString = QStringLiteral("UPDATE queue SET qindex = qindex + (SELECT count(*) from track WHERE %2) WHERE qindex >= %1;"
-                                     "INSERT INTO queue(qindex, track_index) SELECT (SELECT COUNT(*) FROM track t1 WHERE t1.id <= t2.id AND %2)"
-                                     "+ %1 - 1, id from track t2 WHERE %2;"
-                                     "SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id ORDER BY queue.qindex LIMIT %1, (SELECT count(*) from track WHERE %2)")
-                .arg(index)
-                .arg(whereClause);
+        const QString name = item->name();
+        statements.append({QStringLiteral("UPDATE queue SET qindex = qindex + (SELECT count(*) from track WHERE %1) WHERE qindex >= ?").arg(whereClause),
+                           {name, index}});
+        statements.append({QStringLiteral("INSERT INTO queue(qindex, track_index) SELECT (SELECT COUNT(*) FROM track t1 WHERE t1.id <= t2.id AND %1)"
+                                          "+ ? - 1, id from track t2 WHERE %1").arg(whereClause),
+                           {name, index, name}});
+        statements.append({QStringLiteral("SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id ORDER BY queue.qindex LIMIT ?, (SELECT count(*) from track WHERE %1)").arg(whereClause),
+                           {index, name}});
     }
-    QStringList queries = queryString.split(';');
 
     QtConcurrent::run(m_threadPool, this,
                       &MediaPlayerBackend::doSqlOperation,
                       MediaPlayerBackend::Insert,
-                      queries, QUuid(), index, 0);
+                      statements, QUuid(), index, 0);
 }
 
 void MediaPlayerBackend::remove(int index)
 {
-    QString queryString = QStringLiteral("DELETE FROM queue WHERE qindex=%1;"
-                                         "UPDATE queue SET qindex = qindex - 1 WHERE qindex >= %1")
-            .arg(index);
-    QStringList queries = queryString.split(';');
+    QVector<SqlStatement> statements;
+    statements.append({QStringLiteral("DELETE FROM queue WHERE qindex=?"), {index}});
+    statements.append({QStringLiteral("UPDATE queue SET qindex = qindex - 1 WHERE qindex >= ?"), {index}});
 
     QtConcurrent::run(m_threadPool, this,
                       &MediaPlayerBackend::doSqlOperation,
                       MediaPlayerBackend::Remove,
-                      queries, QUuid(), index, 1);
+                      statements, QUuid(), index, 1);
 }
 
 void MediaPlayerBackend::move(int cur_index, int new_index)
@@ -239,21 +242,20 @@ void MediaPlayerBackend::move(int cur_index, int new_index)
     if (delta == 0)
         return;
 
-    QString queryString = QStringLiteral("UPDATE queue SET qindex = ( SELECT MAX(qindex) + 1 FROM queue) WHERE qindex=%1;"
-                                         "UPDATE queue SET qindex = qindex %5 1 WHERE qindex >= %3 AND qindex <= %4;"
-                                         "UPDATE queue SET qindex = %2 WHERE qindex= ( SELECT MAX(qindex) FROM queue);"
-                                         "SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id WHERE qindex >= %3 AND qindex <= %4 ORDER BY qindex")
-            .arg(cur_index)
-            .arg(new_index)
-            .arg(qMin(cur_index, new_index))
-            .arg(qMax(cur_index, new_index))
-            .arg(delta > 0 ? QStringLiteral("-") : QStringLiteral("+"));
-    QStringList queries = queryString.split(';');
+    const int min = qMin(cur_index, new_index);
+    const int max = qMax(cur_index, new_index);
+    QVector<SqlStatement> statements;
+    statements.append({QStringLiteral("UPDATE queue SET qindex = ( SELECT MAX(qindex) + 1 FROM queue) WHERE qindex=?"), {cur_index}});
+    statements.append({QStringLiteral("UPDATE queue SET qindex = qindex %1 1 WHERE qindex >= ? AND qindex <= ?").arg(delta > 0 ? QStringLiteral("-") : QStringLiteral("+")),
+                       {min, max}});
+    statements.append({QStringLiteral("UPDATE queue SET qindex = ? WHERE qindex= ( SELECT MAX(qindex) FROM queue)"), {new_index}});
+    statements.append({QStringLiteral("SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id WHERE qindex >= ? AND qindex <= ? ORDER BY qindex"),
+                       {min, max}});
 
     QtConcurrent::run(m_threadPool, this,
                       &MediaPlayerBackend::doSqlOperation,
                       MediaPlayerBackend::Move,
-                      queries, QUuid(), cur_index, new_index);
+                      statements, QUuid(), cur_index, new_index);
 }
 
 QIviMediaPlayer::PlayMode MediaPlayerBackend::playMode() const
@@ -301,14 +303,16 @@ bool MediaPlayerBackend::canReportCount() const
     return true;
 }
 
-void MediaPlayerBackend::doSqlOperation(MediaPlayerBackend::OperationType type, const QStringList &queries, const QUuid &identifier, int start, int count)
+void MediaPlayerBackend::doSqlOperation(MediaPlayerBackend::OperationType type, const QVector<SqlStatement> &statements, const QUuid &identifier, int start, int count)
 {
-    m_db.transaction();
-    QSqlQuery query(m_db);
+    QSqlDatabase db = m_connections.database();
+    SqlStatementCache *statementCache = m_connections.statements();
+    db.transaction();
+    QSqlQuery query(db);
     QVariantList list;
 
-    for (const QString& queryString : queries) {
-        if (query.exec(queryString)) {
+    for (const SqlStatement &statement : statements) {
+        if (statementCache->exec(&query, statement)) {
             while (query.next()) {
                 QString id = query.value(0).toString();
                 QString artist = query.value(1).toString();
@@ -324,17 +328,18 @@ void MediaPlayerBackend::doSqlOperation(MediaPlayerBackend::OperationType type,
                 item.setCoverArtUrl(QUrl::fromLocalFile(query.value(7).toString()));
                 list.append(QVariant::fromValue(item));
             }
+            query.finish();
         } else {
             sqlError(this, query.lastQuery(), query.lastError().text());
-            m_db.rollback();
+            db.rollback();
             break;
         }
     }
 
-    query.clear();
-    if (query.exec(QStringLiteral("SELECT COUNT(*) FROM queue"))) {
+    if (statementCache->exec(&query, {QStringLiteral("SELECT COUNT(*) FROM queue"), {}})) {
         query.next();
         m_count = query.value(0).toInt();
+        query.finish();
         emit countChanged(m_count);
     } else {
         sqlError(this, query.lastQuery(), query.lastError().text());
@@ -375,7 +380,7 @@ void MediaPlayerBackend::doSqlOperation(MediaPlayerBackend::OperationType type,
                 new_index = m_currentIndex + 1;
             setCurrentIndex(new_index);
             emit dataChanged(list, start, count);
-            m_db.commit();
+            db.commit();
             return;
         }
 
@@ -401,7 +406,7 @@ void MediaPlayerBackend::doSqlOperation(MediaPlayerBackend::OperationType type,
         emit dataChanged(list, start, count);
     }
 
-    m_db.commit();
+    db.commit();
 }
 
 void MediaPlayerBackend::setCurrentIndex(int index)
@@ -424,16 +429,14 @@ void MediaPlayerBackend::setCurrentIndex(int index)
         return;
 
     m_currentIndex = index;
-    QString queryString = QStringLiteral("SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id WHERE queue.qindex=%1 ORDER BY queue.qindex")
-            .arg(m_currentIndex);
-
-    QStringList queries;
-    queries.append(queryString);
+    QVector<SqlStatement> statements;
+    statements.append({QStringLiteral("SELECT track.id, artistName, albumName, trackName, genre, number, file, coverArtUrl FROM track JOIN queue ON queue.track_index=track.id WHERE queue.qindex=? ORDER BY queue.qindex"),
+                       {m_currentIndex}});
 
     QtConcurrent::run(m_threadPool, this,
                       &MediaPlayerBackend::doSqlOperation,
                       MediaPlayerBackend::SetIndex,
-                      queries, QUuid(), m_currentIndex, 0);
+                      statements, QUuid(), m_currentIndex, 0);
 }
 
 void MediaPlayerBackend::setVolume(int volume)
@@ -45,6 +45,9 @@
 
 #include <QtIviMedia/QIviMediaPlayerBackendInterface>
 
+#include "sqlconnectionpool.h"
+#include "sqlstatement.h"
+
 #include <QSqlDatabase>
 #include <QtMultimedia/QMediaPlayer>
 
@@ -74,6 +77,7 @@ public:
     Q_ENUM(OperationType)
 
     MediaPlayerBackend(const QSqlDatabase &database, QObject *parent = nullptr);
+    ~MediaPlayerBackend() override;
 
     void initialize() override;
     void play() override;
@@ -108,7 +112,7 @@ public Q_SLOTS:
     void remove(int index) override;
     void move(int cur_index, int new_index) override;
 
-    void doSqlOperation(MediaPlayerBackend::OperationType type, const QStringList &queries, const QUuid &identifier, int start, int count);
+    void doSqlOperation(MediaPlayerBackend::OperationType type, const QVector<SqlStatement> &statements, const QUuid &identifier, int start, int count);
 
 private Q_SLOTS:
     void onStateChanged(QMediaPlayer::State state);
@@ -126,7 +130,7 @@ private:
     QIviMediaPlayer::PlayState m_state;
     QThreadPool *m_threadPool;
     QMediaPlayer *m_player;
-    QSqlDatabase m_db;
+    SqlConnectionPool m_connections;
 };
 
 #endif // MEDIAPLAYERBACKEND_H
@@ -78,6 +78,8 @@ MediaPlugin::MediaPlugin(QObject *parent)
 
     QObject::connect(m_indexer, &MediaIndexerBackend::removeFromQueue,
                      m_player, &MediaPlayerBackend::remove);
+    QObject::connect(m_indexer, &MediaIndexerBackend::contentChanged,
+                     m_browse, &SearchAndBrowseBackend::invalidateCounts);
     QObject::connect(m_discovery, &MediaDiscoveryBackend::mediaDirectoryAdded,
                      m_indexer, &MediaIndexerBackend::addMediaFolder);
     QObject::connect(m_discovery, &MediaDiscoveryBackend::mediaDirectoryRemoved,
@@ -48,12 +48,30 @@
 #include <QFuture>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QSqlRecord>
+#include <QThread>
 #include <QtDebug>
 
 static const QString artistLiteral = QStringLiteral("artist");
 static const QString albumLiteral = QStringLiteral("album");
 static const QString trackLiteral = QStringLiteral("track");
 
+//The columns containing text, which are divided into sections by their first character and are
+//part of the full-text index
+static const QStringList textColumns = { QStringLiteral("artistName"), QStringLiteral("albumName"),
+                                            QStringLiteral("trackName"), QStringLiteral("genre") };
+
+//The content type showing the children of the item with the given id
+static QString forwardContentType(const QString &contentType, const QString &itemId)
+{
+    QString new_type = contentType + QStringLiteral("?%1").arg(QLatin1String(itemId.toUtf8().toBase64(QByteArray::Base64UrlEncoding)));
+    if (contentType.split('/').last() == artistLiteral)
+        new_type += QLatin1String("/album");
+    else
+        new_type += QLatin1String("/track");
+    return new_type;
+}
+
 QDataStream &operator<<(QDataStream &stream, const SearchAndBrowseItem &obj)
 {
     stream << obj.name();
@@ -83,22 +101,34 @@ QDataStream &operator>>(QDataStream &stream, SearchAndBrowseItem &obj)
 SearchAndBrowseBackend::SearchAndBrowseBackend(const QSqlDatabase &database, QObject *parent)
     : QIviSearchAndBrowseModelInterface(parent)
     , m_threadPool(new QThreadPool(this))
+    , m_connections(database)
+    , m_fullTextIndex(false)
 {
-    m_threadPool->setMaxThreadCount(1);
+    //Every thread uses its own connection, which lets the instances query the database in parallel
+    m_threadPool->setMaxThreadCount(QThread::idealThreadCount());
+
+    //The index is only created if the SQLite version supports it, see createMediaDatabase()
+    QSqlQuery query(database);
+    m_fullTextIndex = query.exec(QStringLiteral("SELECT count() FROM sqlite_master WHERE name = 'track_fts'"))
+            && query.next() && query.value(0).toInt() > 0;
+    query.finish();
 
     qRegisterMetaType<SearchAndBrowseItem>();
     qRegisterMetaTypeStreamOperators<SearchAndBrowseItem>();
     qRegisterMetaType<QIviAudioTrackItem>();
     qRegisterMetaTypeStreamOperators<QIviAudioTrackItem>();
 
-    m_db = database;
-    m_db.open();
-
     m_contentTypes << artistLiteral;
     m_contentTypes << albumLiteral;
     m_contentTypes << trackLiteral;
 }
 
+SearchAndBrowseBackend::~SearchAndBrowseBackend()
+{
+    //The connections are closed by the threads, which need to be done before the pool is destroyed
+    delete m_threadPool;
+}
+
 QStringList SearchAndBrowseBackend::availableContentTypes() const
 {
     return m_contentTypes;
@@ -113,17 +143,26 @@ void SearchAndBrowseBackend::initialize()
 void SearchAndBrowseBackend::registerInstance(const QUuid &identifier)
 {
     m_state.insert(identifier, {});
+    setQueryGeneration(identifier, 0);
 }
 
 void SearchAndBrowseBackend::unregisterInstance(const QUuid &identifier)
 {
     m_state.remove(identifier);
+
+    QMutexLocker locker(&m_queriesMutex);
+    m_queryGenerations.remove(identifier);
 }
 
 void SearchAndBrowseBackend::setContentType(const QUuid &identifier, const QString &contentType)
 {
     auto &state = m_state[identifier];
     state.contentType = contentType;
+    state.queryGeneration++;
+    state.reset();
+    setQueryGeneration(identifier, state.queryGeneration);
+    //The model might still show rows of this content type which aren't fetched again yet
+    state.items.clear();
 
     QStringList types = state.contentType.split('/');
     QString current_type = types.last();
@@ -149,6 +188,9 @@ void SearchAndBrowseBackend::setupFilter(const QUuid &identifier, QIviAbstractQu
     auto &state = m_state[identifier];
     state.queryTerm = term;
     state.orderTerms = orderTerms;
+    state.queryGeneration++;
+    state.reset();
+    setQueryGeneration(identifier, state.queryGeneration);
 }
 
 void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int count)
@@ -159,19 +201,169 @@ void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int c
                                           QtIviCoreModule::SupportsAndConjunction |
                                           QtIviCoreModule::SupportsOrConjunction |
                                           QtIviCoreModule::SupportsStatelessNavigation |
-                                          QtIviCoreModule::SupportsGetSize
+                                          QtIviCoreModule::SupportsGetSize |
+                                          QtIviCoreModule::SupportsSectionIndex
                                           ));
 
     if (!m_state.contains(identifier)) {
         qCCritical(media) << "INTERNAL ERROR: No state available for this uuid";
         return;
     }
-    auto state = m_state[identifier];
+    auto &state = m_state[identifier];
 
     qCDebug(media) << "FETCH" << identifier << state.contentType << start << count;
 
+    const Query select = createQuery(state);
+    const QString whereClause = select.where.query.isEmpty() ? QString() : QStringLiteral("WHERE ") + select.where.query;
+
+    //The count only changes together with the query or the indexed content, which is why it is
+    //only queried for the first chunk and kept until either of them changes.
+    const int queryGeneration = state.queryGeneration;
+    const int generation = state.generation;
+    if (!state.countRequested) {
+        state.countRequested = true;
+
+        SqlStatement countStatement;
+        countStatement.query = QStringLiteral("SELECT count() FROM (SELECT %1 FROM track %2 %3)")
+                .arg(select.columns, whereClause, select.groupBy);
+        countStatement.values = select.where.values;
+
+        //The rows are sorted binary, which means the rows starting with the same character follow
+        //each other and every section is counted by one grouped query
+        SqlStatement sectionStatement;
+        if (select.seekable && !select.keys.isEmpty() && textColumns.contains(select.keys.first().column)) {
+            sectionStatement.query = QStringLiteral("SELECT substr(sectionKey, 1, 1) AS section, count() FROM (SELECT %1 AS sectionKey FROM track %2 %3) GROUP BY section ORDER BY section %4")
+                    .arg(select.keys.first().column, whereClause, select.groupBy,
+                         select.keys.first().ascending ? QStringLiteral("ASC") : QStringLiteral("DESC"));
+            sectionStatement.values = select.where.values;
+        }
+
+        runQuery(identifier, [this, countStatement, sectionStatement, identifier, queryGeneration, generation]() {
+            if (isOutdated(identifier, queryGeneration))
+                return;
+
+            QSqlQuery query(m_connections.database());
+            if (m_connections.statements()->exec(&query, countStatement)) {
+                const int count = query.next() ? query.value(0).toInt() : 0;
+                query.finish();
+
+                QMetaObject::invokeMethod(this, [this, identifier, generation, count]() {
+                    auto it = m_state.find(identifier);
+                    if (it == m_state.end() || it->generation != generation)
+                        return;
+                    it->count = count;
+                    emit countChanged(identifier, count);
+                }, Qt::QueuedConnection);
+            } else {
+                sqlError(this, query.lastQuery(), query.lastError().text());
+            }
+
+            if (sectionStatement.query.isEmpty())
+                return;
+
+            QVariantList sections;
+            if (m_connections.statements()->exec(&query, sectionStatement)) {
+                int index = 0;
+                while (query.next()) {
+                    sections.append(QVariantMap{{QStringLiteral("section"), query.value(0).toString()},
+                                                {QStringLiteral("index"), index}});
+                    index += query.value(1).toInt();
+                }
+                query.finish();
+
+                QMetaObject::invokeMethod(this, [this, identifier, generation, sections]() {
+                    auto it = m_state.find(identifier);
+                    if (it == m_state.end() || it->generation != generation)
+                        return;
+                    it->sections = sections;
+                    emit sectionsChanged(identifier, sections);
+                }, Qt::QueuedConnection);
+            } else {
+                sqlError(this, query.lastQuery(), query.lastError().text());
+            }
+        });
+    } else if (state.count >= 0 && start == 0) {
+        //The model got reset without changing the query
+        emit countChanged(identifier, state.count);
+        if (!state.sections.isEmpty())
+            emit sectionsChanged(identifier, state.sections);
+    }
+
+    //The sort keys of the last row are selected as well, to be able to seek to the following chunk.
+    //Chunks without a known predecessor, e.g. in the DataChanged loading type, use the offset.
+    SqlStatement statement = select.where;
+    QString selectColumns = select.columns;
+    int keyColumn = -1;
+    bool seek = false;
+    if (select.seekable) {
+        keyColumn = select.columns.count(QLatin1Char(',')) + 1;
+        for (const SqlQueryTranslator::SortKey &key : select.keys)
+            selectColumns += QStringLiteral(", ") + key.column;
+        seek = start > 0 && SqlQueryTranslator::appendSeekCondition(&statement, select.keys, state.chunkKeys.value(start));
+    }
+
+    //The pagination is bound as well, to reuse the statement for all chunks
+    statement.query = QStringLiteral("SELECT %1 FROM track %2 %3 %4 %5")
+            .arg(selectColumns,
+                 statement.query.isEmpty() ? QString() : QStringLiteral("WHERE ") + statement.query,
+                 select.groupBy,
+                 select.order,
+                 seek ? QStringLiteral("LIMIT ?") : QStringLiteral("LIMIT ?, ?"));
+    if (!seek)
+        statement.values << start;
+    statement.values << count;
+
+    const QString type = select.type;
+    const int fetchId = ++state.lastFetchId;
+    state.fetches.append({fetchId, start, count});
+    runQuery(identifier, [this, identifier, statement, type, start, count, keyColumn, queryGeneration, generation, fetchId]() {
+        search(identifier, statement, type, start, count, keyColumn, queryGeneration, generation, fetchId);
+    }, fetchId);
+}
+
+bool SearchAndBrowseBackend::cancelFetch(const QUuid &identifier, int start, int count)
+{
+    //Without a state no reply is sent anymore
+    auto it = m_state.find(identifier);
+    if (it == m_state.end())
+        return true;
+
+    //The oldest fetch of this range is the one which is cancelled
+    int fetchId = -1;
+    for (int i = 0; i < it->fetches.count(); i++) {
+        const Fetch &fetch = it->fetches.at(i);
+        if (fetch.start == start && fetch.count == count) {
+            fetchId = fetch.id;
+            it->fetches.removeAt(i);
+            break;
+        }
+    }
+
+    //The reply was sent already
+    if (fetchId < 0)
+        return false;
+
+    //Drop the query if it is still waiting for the thread. The result of a running query is
+    //dropped once it arrives, as the fetch isn't known anymore.
+    QMutexLocker locker(&m_queriesMutex);
+    auto queriesIt = m_queries.find(identifier);
+    if (queriesIt != m_queries.end()) {
+        for (int i = 1; i < queriesIt->count(); i++) {
+            if (queriesIt->at(i).fetchId == fetchId) {
+                queriesIt->removeAt(i);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+SearchAndBrowseBackend::Query SearchAndBrowseBackend::createQuery(const State &state)
+{
     //Determine the current type and which items got selected previously to define the base filter.
-    QStringList where_clauses;
+    //All values are bound to the statement, which is only compiled once for every query structure.
+    Query select;
+    SqlStatement &where = select.where;
     QStringList types = state.contentType.split('/');
     for (const QString &filter_type : types) {
         QStringList parts = filter_type.split('?');
@@ -179,73 +371,89 @@ void SearchAndBrowseBackend::fetchData(const QUuid &identifier, int start, int c
             continue;
 
         QString filter = QString::fromUtf8(QByteArray::fromBase64(parts.at(1).toUtf8(), QByteArray::Base64UrlEncoding));
-        where_clauses.append(QStringLiteral("%1 = \"%2\"").arg(mapIdentifiers(parts.at(0), QStringLiteral("name")), filter));
+        if (!where.query.isEmpty())
+            where.query += QStringLiteral(" AND ");
+        where.query += QStringLiteral("%1 = ?").arg(mapIdentifiers(parts.at(0), QStringLiteral("name")));
+        where.values.append(filter);
     }
-    QString current_type = types.last();
+    const QString current_type = types.last();
+    select.type = current_type;
 
-    QString order;
-    if (!state.orderTerms.isEmpty())
-        order = QStringLiteral("ORDER BY %1").arg(createSortOrder(current_type, state.orderTerms));
+    SqlQueryTranslator translator([this, current_type](const QString &identifier) {
+        return mapIdentifiers(current_type, identifier);
+    });
+    if (m_fullTextIndex)
+        translator.setFullTextIndex({QStringLiteral("track_fts"), QStringLiteral("id"), textColumns});
 
-    QString columns;
-    QString groupBy;
+    QString &columns = select.columns;
+    QString &groupBy = select.groupBy;
+    QStringList uniqueColumns;
     if (current_type == artistLiteral) {
         columns = QStringLiteral("artistName, coverArtUrl");
         groupBy = QStringLiteral("artistName");
+        uniqueColumns = QStringList({QStringLiteral("artistName")});
     } else if (current_type == albumLiteral) {
         columns = QStringLiteral("artistName, albumName, coverArtUrl");
         groupBy = QStringLiteral("artistName, albumName");
+        uniqueColumns = QStringList({QStringLiteral("artistName"), QStringLiteral("albumName")});
     } else {
         columns = QStringLiteral("artistName, albumName, trackName, genre, number, file, id, coverArtUrl");
+        uniqueColumns = QStringList({QStringLiteral("id")});
     }
 
-    QString filterClause = createWhereClause(current_type, state.queryTerm);
-    if (!filterClause.isEmpty())
-        where_clauses.append(filterClause);
-
-    QString whereClause = where_clauses.join(QStringLiteral(" AND "));
+    //The chunks are fetched by seeking to the last row of the previous chunk, instead of letting
+    //SQLite skip all rows before the chunk. This needs a distinct order of the rows, which is only
+    //known for grouped rows if they are sorted by the grouped columns.
+    select.keys = translator.sortKeys(state.orderTerms, uniqueColumns);
+    for (const SqlQueryTranslator::SortKey &key : qAsConst(select.keys)) {
+        if (!groupBy.isEmpty() && !uniqueColumns.contains(key.column))
+            select.seekable = false;
+    }
 
-    QString countQuery = QStringLiteral("SELECT count() FROM (SELECT %1 FROM track %2 %3)")
-            .arg(columns,
-                 whereClause.isEmpty() ? QString() : QStringLiteral("WHERE ") + whereClause,
-                 groupBy.isEmpty() ? QString() : QStringLiteral("GROUP BY ") + groupBy);
+    if (select.seekable)
+        select.order = QStringLiteral("ORDER BY %1").arg(SqlQueryTranslator::orderClause(select.keys));
+    else if (!state.orderTerms.isEmpty())
+        select.order = QStringLiteral("ORDER BY %1").arg(translator.orderClause(state.orderTerms));
+
+    if (state.queryTerm) {
+        if (!where.query.isEmpty())
+            where.query += QStringLiteral(" AND ");
+        where.query += QLatin1Char('(');
+        translator.appendCondition(&where, state.queryTerm);
+        where.query += QLatin1Char(')');
+    }
 
-    QtConcurrent::run(m_threadPool, [this, countQuery, identifier]() {
-        QSqlQuery query(m_db);
-        if (query.exec(countQuery)) {
-            while (query.next()) {
-                emit countChanged(identifier, query.value(0).toInt());
-            }
-        } else {
-            sqlError(this, query.lastQuery(), query.lastError().text());
-        }
-    });
+    if (!groupBy.isEmpty())
+        groupBy.prepend(QStringLiteral("GROUP BY "));
 
-    QString queryString = QStringLiteral("SELECT %1 FROM track %2 %3 %4 LIMIT %5, %6")
-            .arg(columns,
-            whereClause.isEmpty() ? QString() : QStringLiteral("WHERE ") + whereClause,
-            order,
-            groupBy.isEmpty() ? QString() : QStringLiteral("GROUP BY ") + groupBy,
-            QString::number(start),
-            QString::number(count));
-
-    QtConcurrent::run(m_threadPool,
-                      this,
-                      &SearchAndBrowseBackend::search,
-                      identifier,
-                      queryString,
-                      current_type,
-                      start,
-                      count);
+    return select;
 }
 
-void SearchAndBrowseBackend::search(const QUuid &identifier, const QString &queryString, const QString &type, int start, int count)
+void SearchAndBrowseBackend::search(const QUuid &identifier, const SqlStatement &statement, const QString &type, int start, int count, int keyColumn, int queryGeneration, int generation, int fetchId)
 {
+    //The query changed while waiting for the thread, e.g. while the user is typing. Nobody is
+    //interested in the result anymore, but a fetch which wasn't cancelled still gets a reply.
+    if (isOutdated(identifier, queryGeneration)) {
+        qCDebug(media) << "Skipping outdated fetch" << identifier << start << count;
+        QMetaObject::invokeMethod(this, [this, identifier, fetchId, type, start, count, queryGeneration, generation]() {
+            fetched(identifier, fetchId, type, start, count, queryGeneration, generation, QVariantList(), QVariantList());
+        }, Qt::QueuedConnection);
+        return;
+    }
+
     QVariantList list;
-    QSqlQuery query(m_db);
+    QVariantList lastKey;
+    QSqlQuery query(m_connections.database());
 
-    if (query.exec(queryString)) {
+    if (m_connections.statements()->exec(&query, statement)) {
+        const int columnCount = keyColumn >= 0 ? query.record().count() : 0;
         while (query.next()) {
+            if (keyColumn >= 0) {
+                lastKey.clear();
+                for (int i = keyColumn; i < columnCount; i++)
+                    lastKey.append(query.value(i));
+            }
+
             QString artist = query.value(0).toString();
             QString album = query.value(1).toString();
 
@@ -293,42 +501,103 @@ void SearchAndBrowseBackend::search(const QUuid &identifier, const QString &quer
 //                list.append(trackItem);
 //            }
         }
+        query.finish();
     } else {
         qCWarning(media) << query.lastError().text();
     }
 
+    //This runs on a thread of the pool, the state is only changed by the backend's thread
+    QMetaObject::invokeMethod(this, [this, identifier, fetchId, type, start, count, queryGeneration, generation, list, lastKey]() {
+        fetched(identifier, fetchId, type, start, count, queryGeneration, generation, list, lastKey);
+    }, Qt::QueuedConnection);
+}
+
+void SearchAndBrowseBackend::fetched(const QUuid &identifier, int fetchId, const QString &type, int start, int count, int queryGeneration, int generation, const QVariantList &list, const QVariantList &lastKey)
+{
+    //The model cancelled the fetch and doesn't expect a reply anymore
+    auto it = m_state.find(identifier);
+    if (it == m_state.end() || !it->takeFetch(fetchId))
+        return;
+
+    //The model discards the reply of an outdated query
+    if (it->queryGeneration != queryGeneration) {
+        emit dataFetched(identifier, QVariantList(), start, false);
+        return;
+    }
+
+    //Remember where the next chunk starts, before the model is able to request it
+    if (!lastKey.isEmpty() && it->generation == generation)
+        it->chunkKeys.insert(start + list.count(), lastKey);
+
     emit dataFetched(identifier, list, start, list.count() >= count);
 
-    auto &state = m_state[identifier];
     for (int i=0; i < list.count(); i++) {
-        if (start + i >= state.items.count())
-            state.items.append(list.at(i));
+        if (start + i >= it->items.count())
+            it->items.append(list.at(i));
         else
-            state.items.replace(start + i, list.at(i));
+            it->items.replace(start + i, list.at(i));
     }
 
     if (type == artistLiteral || type == albumLiteral)
         emit canGoForwardChanged(identifier, QVector<bool>(list.count(), true), start);
 }
 
-QString SearchAndBrowseBackend::createSortOrder(const QString &type, const QList<QIviOrderTerm> &orderTerms)
+bool SearchAndBrowseBackend::isOutdated(const QUuid &identifier, int queryGeneration) const
 {
-    QStringList order;
-    int i = 0;
-    for (const QIviOrderTerm & term : orderTerms) {
-        if (i)
-            order.append(QStringLiteral(","));
-
-        order.append(mapIdentifiers(type, term.propertyName()));
-        if (term.isAscending())
-            order.append(QStringLiteral("ASC"));
-        else
-            order.append(QStringLiteral("DESC"));
+    QMutexLocker locker(&m_queriesMutex);
+    auto it = m_queryGenerations.constFind(identifier);
+    return it == m_queryGenerations.constEnd() || *it != queryGeneration;
+}
+
+void SearchAndBrowseBackend::setQueryGeneration(const QUuid &identifier, int queryGeneration)
+{
+    QMutexLocker locker(&m_queriesMutex);
+    m_queryGenerations.insert(identifier, queryGeneration);
+}
+
+void SearchAndBrowseBackend::runQuery(const QUuid &identifier, const std::function<void()> &query, int fetchId)
+{
+    //The queries of an instance are run one after the other, to deliver the chunks in order and to
+    //know the last row of the previous chunk. Only the queries of different instances run in parallel.
+    QMutexLocker locker(&m_queriesMutex);
+    QQueue<QueuedQuery> &queries = m_queries[identifier];
+    queries.enqueue({fetchId, query});
+    if (queries.count() == 1)
+        QtConcurrent::run(m_threadPool, this, &SearchAndBrowseBackend::runQueries, identifier);
+}
 
-        i++;
+void SearchAndBrowseBackend::runQueries(const QUuid &identifier)
+{
+    QMutexLocker locker(&m_queriesMutex);
+    forever {
+        const std::function<void()> query = m_queries[identifier].head().run;
+        locker.unlock();
+        query();
+        locker.relock();
+
+        QQueue<QueuedQuery> &queries = m_queries[identifier];
+        queries.dequeue();
+        if (queries.isEmpty()) {
+            m_queries.remove(identifier);
+            return;
+        }
     }
+}
 
-    return order.join(' ');
+void SearchAndBrowseBackend::invalidateCounts()
+{
+    //The content of the database changed, which also moves the rows the chunks start at
+    for (auto it = m_state.begin(); it != m_state.end(); ++it)
+        it->reset();
+
+    //Let the models fetch their rows and the count again. They set up their query again, which
+    //drops the replies of the outdated queries.
+    const QList<QUuid> identifiers = m_state.keys();
+    for (const QUuid &identifier : identifiers) {
+        auto it = m_state.constFind(identifier);
+        if (it != m_state.constEnd() && !it->contentType.isEmpty())
+            emit contentTypeChanged(identifier, it->contentType);
+    }
 }
 
 QString SearchAndBrowseBackend::mapIdentifiers(const QString &type, const QString &identifer)
@@ -345,65 +614,6 @@ QString SearchAndBrowseBackend::mapIdentifiers(const QString &type, const QStrin
     return identifer;
 }
 
-QString SearchAndBrowseBackend::createWhereClause(const QString &type, QIviAbstractQueryTerm *term)
-{
-    if (!term)
-        return QString();
-
-    switch (term->type()) {
-    case QIviAbstractQueryTerm::ScopeTerm: {
-        auto *scope = static_cast<QIviScopeTerm*>(term);
-        return QStringLiteral("%1 (%2)").arg(scope->isNegated() ? QStringLiteral("NOT") : QString(), createWhereClause(type, scope->term()));
-    }
-    case QIviAbstractQueryTerm::ConjunctionTerm: {
-        auto *conjunctionTerm = static_cast<QIviConjunctionTerm*>(term);
-        QLatin1String conjunction = QLatin1String("AND");
-        if (conjunctionTerm->conjunction() == QIviConjunctionTerm::Or)
-            conjunction = QLatin1String("OR");
-
-        QString string;
-        const auto terms = conjunctionTerm->terms();
-        for (QIviAbstractQueryTerm *term : terms) {
-            string += createWhereClause(type, term) + QLatin1Char(' ') + conjunction + QLatin1Char(' ');
-        }
-        if (!string.isEmpty())
-            string.chop(2 + conjunction.size()); // chop off trailing " AND " or " OR "
-        return string;
-    }
-    case QIviAbstractQueryTerm::FilterTerm: {
-        auto *filter = static_cast<QIviFilterTerm*>(term);
-        QString operatorString;
-        bool negated = filter->isNegated();
-        QString value;
-        if (filter->value().type() == QVariant::String)
-            value = QStringLiteral("'%1'").arg(filter->value().toString().replace('*', '%'));
-        else
-            value = filter->value().toString();
-
-        switch (filter->operatorType()){
-            case QIviFilterTerm::Equals: operatorString = QStringLiteral("="); break;
-            case QIviFilterTerm::EqualsCaseInsensitive: operatorString = QStringLiteral("LIKE"); break;
-            case QIviFilterTerm::Unequals: operatorString = QStringLiteral("="); negated = !negated; break;
-            case QIviFilterTerm::GreaterThan: operatorString = QStringLiteral(">"); break;
-            case QIviFilterTerm::GreaterEquals: operatorString = QStringLiteral(">="); break;
-            case QIviFilterTerm::LowerThan: operatorString = QStringLiteral("<"); break;
-            case QIviFilterTerm::LowerEquals: operatorString = QStringLiteral("<="); break;
-        }
-
-        QStringList clause;
-        if (negated)
-            clause.append(QStringLiteral("NOT"));
-        clause.append(mapIdentifiers(type, filter->propertyName()));
-        clause.append(operatorString);
-        clause.append(value);
-
-        return clause.join(QStringLiteral(" "));
-    }
-    }
-
-    return QString();
-}
-
 QIviPendingReply<QString> SearchAndBrowseBackend::goBack(const QUuid &identifier)
 {
     auto &state = m_state[identifier];
@@ -420,26 +630,58 @@ QIviPendingReply<QString> SearchAndBrowseBackend::goBack(const QUuid &identifier
 
 QIviPendingReply<QString> SearchAndBrowseBackend::goForward(const QUuid &identifier, int index)
 {
-    auto &state = m_state[identifier];
-
-    const QIviStandardItem *i = qtivi_gadgetFromVariant<QIviStandardItem>(this, state.items.value(index, QVariant()));
-    if (!i)
+    auto it = m_state.find(identifier);
+    if (it == m_state.end())
         return QIviPendingReply<QString>::createFailedReply();
+    const State &state = *it;
 
-    QString itemId = i->id();
-    QStringList types = state.contentType.split('/');
-
-    QString current_type = types.last();
-    QString new_type = state.contentType + QStringLiteral("?%1").arg(QLatin1String(itemId.toUtf8().toBase64(QByteArray::Base64UrlEncoding)));
-
-    if (current_type == artistLiteral)
-        new_type += QLatin1String("/album");
-    else if (current_type == albumLiteral)
-        new_type += QLatin1String("/track");
-    else
+    const QString current_type = state.contentType.split('/').last();
+    if (current_type != artistLiteral && current_type != albumLiteral)
         return QIviPendingReply<QString>::createFailedReply();
 
-    return QIviPendingReply<QString>(new_type);
+    const QIviStandardItem *i = qtivi_gadgetFromVariant<QIviStandardItem>(this, state.items.value(index, QVariant()));
+    if (i)
+        return QIviPendingReply<QString>(forwardContentType(state.contentType, i->id()));
+
+    //The row wasn't fetched since the content type got set, e.g. because the model restored it
+    //from its navigation history. Its id is queried on demand.
+    const Query select = createQuery(state);
+    SqlStatement statement = select.where;
+    statement.query = QStringLiteral("SELECT %1 FROM track %2 %3 %4 LIMIT ?, 1")
+            .arg(select.columns,
+                 statement.query.isEmpty() ? QString() : QStringLiteral("WHERE ") + statement.query,
+                 select.groupBy,
+                 select.order);
+    statement.values << index;
+
+    const int idColumn = current_type == artistLiteral ? 0 : 1;
+    const QString contentType = state.contentType;
+    const int queryGeneration = state.queryGeneration;
+    QIviPendingReply<QString> reply;
+    runQuery(identifier, [this, identifier, statement, idColumn, contentType, queryGeneration, reply]() {
+        bool found = false;
+        QString itemId;
+        if (!isOutdated(identifier, queryGeneration)) {
+            QSqlQuery query(m_connections.database());
+            if (m_connections.statements()->exec(&query, statement)) {
+                found = query.next();
+                if (found)
+                    itemId = query.value(idColumn).toString();
+                query.finish();
+            } else {
+                sqlError(this, query.lastQuery(), query.lastError().text());
+            }
+        }
+
+        //The reply is resolved by the backend's thread, like the replies of the other calls
+        QMetaObject::invokeMethod(this, [reply, found, contentType, itemId]() mutable {
+            if (found)
+                reply.setSuccess(forwardContentType(contentType, itemId));
+            else
+                reply.setFailed();
+        }, Qt::QueuedConnection);
+    });
+    return reply;
 }
 
 QIviPendingReply<void> SearchAndBrowseBackend::insert(const QUuid &identifier, int index, const QVariant &item)
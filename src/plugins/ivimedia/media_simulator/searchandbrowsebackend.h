@@ -47,9 +47,17 @@
 #include <QtIviCore/QIviSearchAndBrowseModelInterface>
 #include <QtIviMedia/QIviAudioTrackItem>
 
+#include "sqlconnectionpool.h"
+#include "sqlstatement.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QQueue>
 #include <QSqlDatabase>
 #include <QStack>
 
+#include <functional>
+
 QT_FORWARD_DECLARE_CLASS(QThreadPool);
 
 class SearchAndBrowseItem : public QIviPlayableItem
@@ -79,6 +87,7 @@ class SearchAndBrowseBackend : public QIviSearchAndBrowseModelInterface
     Q_PROPERTY(QStringList availableContentTypes READ availableContentTypes CONSTANT)
 public:
     explicit SearchAndBrowseBackend(const QSqlDatabase &database, QObject *parent = nullptr);
+    ~SearchAndBrowseBackend() override;
 
     QStringList availableContentTypes() const;
 
@@ -88,6 +97,7 @@ public:
     void setContentType(const QUuid &identifier, const QString &contentType) override;
     void setupFilter(const QUuid &identifier, QIviAbstractQueryTerm *term, const QList<QIviOrderTerm> &orderTerms) override;
     void fetchData(const QUuid &identifier, int start, int count) override;
+    bool cancelFetch(const QUuid &identifier, int start, int count) override;
     QIviPendingReply<QString> goBack(const QUuid &identifier) override;
     QIviPendingReply<QString> goForward(const QUuid &identifier, int index) override;
 
@@ -96,23 +106,92 @@ public:
     QIviPendingReply<void> move(const QUuid &identifier, int currentIndex, int newIndex) override;
     QIviPendingReply<int> indexOf(const QUuid &identifier, const QVariant &item) override;
 
+public slots:
+    void invalidateCounts();
+
 private slots:
-    void search(const QUuid &identifier, const QString &queryString, const QString &type, int start, int count);
-    QString createSortOrder(const QString &type, const QList<QIviOrderTerm> &orderTerms);
-    QString createWhereClause(const QString &type, QIviAbstractQueryTerm *term);
+    void search(const QUuid &identifier, const SqlStatement &statement, const QString &type, int start, int count, int keyColumn, int queryGeneration, int generation, int fetchId);
 private:
+    void fetched(const QUuid &identifier, int fetchId, const QString &type, int start, int count, int queryGeneration, int generation, const QVariantList &list, const QVariantList &lastKey);
     QString mapIdentifiers(const QString &type, const QString &identifer);
+    bool isOutdated(const QUuid &identifier, int queryGeneration) const;
+    void setQueryGeneration(const QUuid &identifier, int queryGeneration);
+    void runQuery(const QUuid &identifier, const std::function<void()> &query, int fetchId = -1);
+    void runQueries(const QUuid &identifier);
 
-    QSqlDatabase m_db;
     QThreadPool *m_threadPool;
+    SqlConnectionPool m_connections;
+    bool m_fullTextIndex;
+    mutable QMutex m_queriesMutex;
+    struct QueuedQuery {
+        //The fetch answered by this query, -1 for all other queries
+        int fetchId;
+        std::function<void()> run;
+    };
+    //The queries of every instance, the first one is running
+    QHash<QUuid, QQueue<QueuedQuery>> m_queries;
+    //A copy of State::queryGeneration, for the threads to skip outdated queries
+    QHash<QUuid, int> m_queryGenerations;
     QStringList m_contentTypes;
+    struct Fetch {
+        int id;
+        int start;
+        int count;
+    };
     struct State {
         QString contentType;
         QIviAbstractQueryTerm *queryTerm = nullptr;
         QList<QIviOrderTerm> orderTerms;
         QVariantList items;
+        //The sort keys of the last row before a chunk, indexed by the start of the chunk
+        QHash<int, QVariantList> chunkKeys;
+        //The number of rows matching the query, -1 if not known yet
+        int count = -1;
+        bool countRequested = false;
+        //The first character of the first sort key and the row it starts at, queried with the count
+        QVariantList sections;
+        //Changes with the query
+        int queryGeneration = 0;
+        //Changes with the query and the indexed content
+        int generation = 0;
+        //The fetches which are not answered yet, in the order they were requested
+        QList<Fetch> fetches;
+        int lastFetchId = 0;
+
+        void reset()
+        {
+            generation++;
+            chunkKeys.clear();
+            count = -1;
+            countRequested = false;
+            sections.clear();
+        }
+
+        bool takeFetch(int fetchId)
+        {
+            for (int i = 0; i < fetches.count(); i++) {
+                if (fetches.at(i).id == fetchId) {
+                    fetches.removeAt(i);
+                    return true;
+                }
+            }
+            return false;
+        }
     };
+    //Only accessed by the backend's thread, the threads hand their results over to it
     QMap<QUuid, State> m_state;
+
+    //The parts of the query selecting the rows of a state
+    struct Query {
+        QString type;
+        SqlStatement where;
+        QString columns;
+        QString groupBy;
+        QString order;
+        QVector<SqlQueryTranslator::SortKey> keys;
+        bool seekable = true;
+    };
+    Query createQuery(const State &state);
 };
 
 #endif // SEARCHBACKEND_H
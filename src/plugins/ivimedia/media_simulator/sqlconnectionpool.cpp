@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+
+#include "sqlconnectionpool.h"
+#include "logging.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+//The pages cached by every connection, negative values are in KiB instead of pages
+static const int cacheSize = -8192;
+//The part of the database file which is read using memory mapped I/O, in bytes
+static const qint64 mmapSize = 64 * 1024 * 1024;
+
+SqlConnectionPool::SqlConnectionPool(const QSqlDatabase &database, int statementCacheSize)
+    : m_connectionName(database.connectionName())
+    , m_databaseName(database.databaseName())
+    , m_statementCacheSize(statementCacheSize)
+{
+}
+
+QSqlDatabase SqlConnectionPool::database()
+{
+    return QSqlDatabase::database(connection()->name, false);
+}
+
+SqlStatementCache *SqlConnectionPool::statements()
+{
+    return connection()->statements;
+}
+
+//Sets up a newly opened connection. The journal mode is stored in the database file and set when
+//creating it: the write-ahead log lets the connections read while another one is writing.
+bool SqlConnectionPool::configure(QSqlDatabase &database)
+{
+    QSqlQuery query(database);
+    if (!query.exec(QStringLiteral("PRAGMA cache_size = %1").arg(cacheSize))
+            || !query.exec(QStringLiteral("PRAGMA mmap_size = %1").arg(mmapSize))) {
+        qCWarning(media) << "Couldn't configure the database connection:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+SqlConnectionPool::Connection *SqlConnectionPool::connection()
+{
+    if (m_connections.hasLocalData())
+        return m_connections.localData();
+
+    auto *connection = new Connection;
+    connection->name = QStringLiteral("%1-%2").arg(m_connectionName).arg(m_connectionCount.fetchAndAddRelaxed(1));
+
+    QSqlDatabase database = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connection->name);
+    database.setDatabaseName(m_databaseName);
+    if (database.open())
+        configure(database);
+    else
+        qCWarning(media) << "Couldn't open the database:" << database.lastError().text();
+
+    connection->statements = new SqlStatementCache(database, m_statementCacheSize);
+    m_connections.setLocalData(connection);
+    return connection;
+}
+
+SqlConnectionPool::Connection::~Connection()
+{
+    //All copies of the connection need to be gone before it can be removed
+    delete statements;
+    QSqlDatabase::database(name, false).close();
+    QSqlDatabase::removeDatabase(name);
+}
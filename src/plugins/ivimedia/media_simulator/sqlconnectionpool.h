@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+
+#ifndef SQLCONNECTIONPOOL_H
+#define SQLCONNECTIONPOOL_H
+
+#include "sqlstatement.h"
+
+#include <QAtomicInt>
+#include <QSqlDatabase>
+#include <QThreadStorage>
+
+//Opens a connection to the database for every thread using it. A QSqlDatabase can only be used
+//by the thread which created it and SQLite can only run the queries of different connections in
+//parallel. Every connection has its own prepared statements. The connection of a thread is
+//closed once the thread exits, which means the threads need to be done before the pool is
+//destroyed.
+class SqlConnectionPool
+{
+public:
+    explicit SqlConnectionPool(const QSqlDatabase &database, int statementCacheSize = 32);
+
+    QSqlDatabase database();
+    SqlStatementCache *statements();
+
+    static bool configure(QSqlDatabase &database);
+
+private:
+    struct Connection {
+        ~Connection();
+
+        QString name;
+        SqlStatementCache *statements;
+    };
+    Connection *connection();
+
+    QString m_connectionName;
+    QString m_databaseName;
+    int m_statementCacheSize;
+    QAtomicInt m_connectionCount;
+    QThreadStorage<Connection *> m_connections;
+};
+
+#endif // SQLCONNECTIONPOOL_H
@@ -0,0 +1,251 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#include "sqlstatement.h"
+
+#include <QRegularExpression>
+
+SqlQueryTranslator::SqlQueryTranslator(const IdentifierMapper &mapper)
+    : m_mapper(mapper)
+{
+}
+
+void SqlQueryTranslator::setFullTextIndex(const FullTextIndex &index)
+{
+    m_fullTextIndex = index;
+}
+
+void SqlQueryTranslator::appendCondition(SqlStatement *statement, const QIviAbstractQueryTerm *term) const
+{
+    if (!term)
+        return;
+
+    switch (term->type()) {
+    case QIviAbstractQueryTerm::ScopeTerm: {
+        auto *scope = static_cast<const QIviScopeTerm*>(term);
+        if (scope->isNegated())
+            statement->query += QStringLiteral("NOT ");
+        statement->query += QLatin1Char('(');
+        appendCondition(statement, scope->term());
+        statement->query += QLatin1Char(')');
+        break;
+    }
+    case QIviAbstractQueryTerm::ConjunctionTerm: {
+        auto *conjunctionTerm = static_cast<const QIviConjunctionTerm*>(term);
+        const QString conjunction = conjunctionTerm->conjunction() == QIviConjunctionTerm::Or ? QStringLiteral(" OR ")
+                                                                                               : QStringLiteral(" AND ");
+        const auto terms = conjunctionTerm->terms();
+        for (int i = 0; i < terms.count(); i++) {
+            if (i)
+                statement->query += conjunction;
+            appendCondition(statement, terms.at(i));
+        }
+        break;
+    }
+    case QIviAbstractQueryTerm::FilterTerm: {
+        auto *filter = static_cast<const QIviFilterTerm*>(term);
+        bool negated = filter->isNegated();
+        QVariant value = filter->value();
+        QString operatorString;
+
+        switch (filter->operatorType()){
+            case QIviFilterTerm::Equals: operatorString = QStringLiteral("="); break;
+            case QIviFilterTerm::EqualsCaseInsensitive: operatorString = QStringLiteral("LIKE"); break;
+            case QIviFilterTerm::Unequals: operatorString = QStringLiteral("="); negated = !negated; break;
+            case QIviFilterTerm::GreaterThan: operatorString = QStringLiteral(">"); break;
+            case QIviFilterTerm::GreaterEquals: operatorString = QStringLiteral(">="); break;
+            case QIviFilterTerm::LowerThan: operatorString = QStringLiteral("<"); break;
+            case QIviFilterTerm::LowerEquals: operatorString = QStringLiteral("<="); break;
+        }
+
+        //The wildcard of the query language is only supported by LIKE
+        if (filter->operatorType() == QIviFilterTerm::EqualsCaseInsensitive && value.type() == QVariant::String)
+            value = value.toString().replace(QLatin1Char('*'), QLatin1Char('%'));
+
+        if (negated)
+            statement->query += QStringLiteral("NOT ");
+        const QString filterColumn = column(filter->propertyName());
+        statement->query += QLatin1Char('(');
+        //A negated filter matches most rows, the full-text index doesn't help there
+        if (!negated && filter->operatorType() == QIviFilterTerm::EqualsCaseInsensitive && value.type() == QVariant::String)
+            appendFullTextCondition(statement, filterColumn, value.toString());
+        statement->query += filterColumn + QLatin1Char(' ') + operatorString + QStringLiteral(" ?)");
+        statement->values.append(value);
+        break;
+    }
+    }
+}
+
+//Preselects the rows containing the longest part of the LIKE pattern without wildcards using the
+//full-text index, instead of matching the pattern against all rows. The trigram tokenizer matches
+//any part of the text case-insensitively, which means it finds all rows matched by the pattern.
+//The pattern is still matched against the preselected rows, as it also defines where the parts
+//need to be.
+void SqlQueryTranslator::appendFullTextCondition(SqlStatement *statement, const QString &column, const QString &pattern) const
+{
+    if (m_fullTextIndex.table.isEmpty() || !m_fullTextIndex.columns.contains(column))
+        return;
+
+    QString text;
+    const QVector<QStringRef> parts = pattern.splitRef(QRegularExpression(QStringLiteral("[%_]")), QString::SkipEmptyParts);
+    for (const QStringRef &part : parts) {
+        if (part.size() > text.size())
+            text = part.toString();
+    }
+
+    //The trigram tokenizer can't match less than three characters
+    if (text.size() < 3)
+        return;
+
+    statement->query += QStringLiteral("%1 IN (SELECT rowid FROM %2 WHERE %2 MATCH ?) AND ")
+            .arg(m_fullTextIndex.rowIdColumn, m_fullTextIndex.table);
+    statement->values.append(QStringLiteral("%1 : \"%2\"").arg(column, text.replace(QLatin1Char('"'), QStringLiteral("\"\""))));
+}
+
+QString SqlQueryTranslator::orderClause(const QList<QIviOrderTerm> &orderTerms) const
+{
+    QStringList order;
+    for (const QIviOrderTerm &term : orderTerms)
+        order.append(column(term.propertyName()) + (term.isAscending() ? QStringLiteral(" ASC") : QStringLiteral(" DESC")));
+
+    return order.join(QStringLiteral(", "));
+}
+
+QVector<SqlQueryTranslator::SortKey> SqlQueryTranslator::sortKeys(const QList<QIviOrderTerm> &orderTerms, const QStringList &uniqueColumns) const
+{
+    //The unique columns are appended to define the order of the rows with equal values
+    QVector<SortKey> keys;
+    QStringList columns;
+    for (const QIviOrderTerm &term : orderTerms) {
+        const QString orderColumn = column(term.propertyName());
+        if (columns.contains(orderColumn))
+            continue;
+        keys.append({orderColumn, term.isAscending()});
+        columns.append(orderColumn);
+    }
+
+    for (const QString &uniqueColumn : uniqueColumns) {
+        if (!columns.contains(uniqueColumn))
+            keys.append({uniqueColumn, true});
+    }
+
+    return keys;
+}
+
+QString SqlQueryTranslator::orderClause(const QVector<SortKey> &keys)
+{
+    QStringList order;
+    for (const SortKey &key : keys)
+        order.append(key.column + (key.ascending ? QStringLiteral(" ASC") : QStringLiteral(" DESC")));
+
+    return order.join(QStringLiteral(", "));
+}
+
+bool SqlQueryTranslator::appendSeekCondition(SqlStatement *statement, const QVector<SortKey> &keys, const QVariantList &lastKey)
+{
+    //NULL values can't be compared, the caller needs to skip the rows instead
+    if (keys.isEmpty() || lastKey.count() != keys.count())
+        return false;
+    for (const QVariant &value : lastKey) {
+        if (value.isNull())
+            return false;
+    }
+
+    //Selects all rows which are sorted after the last key. The row value comparison of SQLite
+    //can't be used, as every key has its own direction. SQLite sorts NULL before all values,
+    //which means they only follow the last key in descending order.
+    QStringList alternatives;
+    for (int i = 0; i < keys.count(); i++) {
+        QStringList conditions;
+        for (int j = 0; j < i; j++) {
+            conditions.append(keys.at(j).column + QStringLiteral(" = ?"));
+            statement->values.append(lastKey.at(j));
+        }
+
+        const QString &column = keys.at(i).column;
+        if (keys.at(i).ascending)
+            conditions.append(column + QStringLiteral(" > ?"));
+        else
+            conditions.append(QStringLiteral("(%1 < ? OR %1 IS NULL)").arg(column));
+        statement->values.append(lastKey.at(i));
+
+        alternatives.append(QLatin1Char('(') + conditions.join(QStringLiteral(" AND ")) + QLatin1Char(')'));
+    }
+
+    if (!statement->query.isEmpty())
+        statement->query += QStringLiteral(" AND ");
+    statement->query += QLatin1Char('(') + alternatives.join(QStringLiteral(" OR ")) + QLatin1Char(')');
+    return true;
+}
+
+QString SqlQueryTranslator::column(const QString &identifier) const
+{
+    //The identifiers are checked by the query parser and don't need to be escaped
+    return m_mapper ? m_mapper(identifier) : identifier;
+}
+
+SqlStatementCache::SqlStatementCache(const QSqlDatabase &database, int size)
+    : m_db(database)
+    , m_statements(size)
+{
+}
+
+bool SqlStatementCache::exec(QSqlQuery *query, const SqlStatement &statement)
+{
+    //The statements only differ in their values, which are bound again for every execution
+    QSqlQuery *prepared = m_statements.object(statement.query);
+    if (!prepared) {
+        prepared = new QSqlQuery(m_db);
+        prepared->setForwardOnly(true);
+        if (!prepared->prepare(statement.query)) {
+            *query = *prepared;
+            delete prepared;
+            return false;
+        }
+        m_statements.insert(statement.query, prepared);
+    }
+
+    for (int i = 0; i < statement.values.count(); i++)
+        prepared->bindValue(i, statement.values.at(i));
+
+    *query = *prepared;
+    return query->exec();
+}
@@ -0,0 +1,116 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+** SPDX-License-Identifier: LGPL-3.0
+**
+****************************************************************************/
+
+#ifndef SQLSTATEMENT_H
+#define SQLSTATEMENT_H
+
+#include <QtIviCore/qiviqueryterm.h>
+
+#include <QCache>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QVariantList>
+#include <QVector>
+
+#include <functional>
+
+//A SQL statement with placeholders and the values bound to them
+struct SqlStatement
+{
+    QString query;
+    QVariantList values;
+};
+
+//Translates the query terms of the QIviSearchAndBrowseModel to SQL. All values are bound to
+//placeholders, which means the generated SQL only depends on the structure of the query.
+class SqlQueryTranslator
+{
+public:
+    typedef std::function<QString(const QString &identifier)> IdentifierMapper;
+
+    struct SortKey {
+        QString column;
+        bool ascending;
+    };
+
+    //A FTS5 table using the trigram tokenizer, which indexes text columns of the queried table
+    struct FullTextIndex {
+        QString table;
+        QString rowIdColumn;
+        QStringList columns;
+    };
+
+    explicit SqlQueryTranslator(const IdentifierMapper &mapper = IdentifierMapper());
+
+    void setFullTextIndex(const FullTextIndex &index);
+
+    void appendCondition(SqlStatement *statement, const QIviAbstractQueryTerm *term) const;
+    QString orderClause(const QList<QIviOrderTerm> &orderTerms) const;
+    QVector<SortKey> sortKeys(const QList<QIviOrderTerm> &orderTerms, const QStringList &uniqueColumns) const;
+    QString column(const QString &identifier) const;
+
+    static QString orderClause(const QVector<SortKey> &keys);
+    static bool appendSeekCondition(SqlStatement *statement, const QVector<SortKey> &keys, const QVariantList &lastKey);
+
+private:
+    void appendFullTextCondition(SqlStatement *statement, const QString &column, const QString &pattern) const;
+
+    IdentifierMapper m_mapper;
+    FullTextIndex m_fullTextIndex;
+};
+
+//Keeps the prepared statements of a database connection, to only compile every statement once.
+//The statements are shared with the returned queries, which means all queries need to be done
+//in the thread of the connection, see SqlConnectionPool. Call QSqlQuery::finish() once all rows
+//are read, as an active statement keeps the database locked.
+class SqlStatementCache
+{
+public:
+    explicit SqlStatementCache(const QSqlDatabase &database, int size = 32);
+
+    bool exec(QSqlQuery *query, const SqlStatement &statement);
+
+private:
+    QSqlDatabase m_db;
+    QCache<QString, QSqlQuery> m_statements;
+};
+
+#endif // SQLSTATEMENT_H
@@ -2,4 +2,5 @@ TEMPLATE = subdirs
 
 qtHaveModule(ivicore): SUBDIRS += core
 qtHaveModule(ivivehiclefunctions): SUBDIRS += vehiclefunctions
+qtHaveModule(ivimedia): SUBDIRS += media
 qtHaveModule(geniviextras): SUBDIRS += dlt
@@ -40,6 +40,8 @@
 #include <QScopedPointer>
 #include <private/qobject_p.h>
 
+#include <functional>
+
 //TODO Add test with multiple model instances, requesting different data at the same time
 //TODO Test the signal without a valid identifier
 
@@ -81,8 +83,18 @@ public:
         emit initializationDone();
     }
 
+    //Gives every instance registered from now on its own data, like a backend which keeps a state
+    //per instance
+    void setInstanceData(const QString &name)
+    {
+        m_instanceDataName = name;
+    }
+
     void registerInstance(const QUuid &identifier) override
     {
+        if (!m_instanceDataName.isEmpty())
+            m_instanceLists.insert(identifier, createItemList(m_instanceDataName));
+        emit supportedCapabilitiesChanged(identifier, m_caps);
         emit registerInstanceCalled(identifier);
     }
 
@@ -95,16 +107,64 @@ public:
     {
         emit supportedCapabilitiesChanged(identifier, m_caps);
 
+        const QList<QIviStandardItem> list = m_instanceLists.value(identifier, m_list);
         if (m_caps.testFlag(QtIviCoreModule::SupportsGetSize))
-            emit countChanged(identifier, m_list.count());
+            emit countChanged(identifier, list.count());
 
         QVariantList requestedItems;
 
-        int size = qMin(start + count, m_list.count());
+        int size = qMin(start + count, list.count());
         for (int i = start; i < size; i++)
-            requestedItems.append(QVariant::fromValue(m_list.at(i)));
+            requestedItems.append(QVariant::fromValue(list.at(i)));
+
+        const bool moreAvailable = start + count < list.count();
+        if (m_deferReplies) {
+            m_pendingReplies.append([=]() {
+                emit dataFetched(identifier, requestedItems, start, moreAvailable);
+            });
+            return;
+        }
+
+        emit dataFetched(identifier, requestedItems, start, moreAvailable);
+    }
 
-        emit dataFetched(identifier, requestedItems, start, start + count < m_list.count());
+    bool cancelFetch(const QUuid &identifier, int start, int count) override
+    {
+        Q_UNUSED(identifier)
+        Q_UNUSED(count)
+        m_cancelledFetches.append(start);
+        return m_cancelFetchResult;
+    }
+
+    //Lets cancelFetch() claim the request was aborted. The deferred reply is still sent.
+    void setCancelFetchResult(bool cancelFetchResult)
+    {
+        m_cancelFetchResult = cancelFetchResult;
+    }
+
+    //Holds back all dataFetched signals until sendPendingReplies() is called
+    void setDeferReplies(bool deferReplies)
+    {
+        m_deferReplies = deferReplies;
+    }
+
+    int pendingReplyCount() const
+    {
+        return m_pendingReplies.count();
+    }
+
+    //Sends the first count replies, or all if count is -1
+    void sendPendingReplies(int count = -1)
+    {
+        const QList<std::function<void()>> replies = m_pendingReplies.mid(0, count);
+        m_pendingReplies = m_pendingReplies.mid(replies.count());
+        for (const std::function<void()> &reply : replies)
+            reply();
+    }
+
+    QList<int> cancelledFetches() const
+    {
+        return m_cancelledFetches;
     }
 
     void insert(int index, const QIviStandardItem item)
@@ -115,6 +175,38 @@ public:
         emit dataChanged(QUuid(), variantList, index, 0);
     }
 
+    //Changes an item without informing the models, like a change which happened while the
+    //application wasn't running
+    void replaceSilently(int index, const QIviStandardItem &item)
+    {
+        m_list.replace(index, item);
+    }
+
+    void insertSilently(int index, const QIviStandardItem &item)
+    {
+        m_list.insert(index, item);
+    }
+
+    void removeSilently(int index)
+    {
+        m_list.removeAt(index);
+    }
+
+    void moveSilently(int currentIndex, int newIndex)
+    {
+        m_list.move(currentIndex, newIndex);
+    }
+
+    QIviStandardItem itemAt(int index) const
+    {
+        return m_list.at(index);
+    }
+
+    int rowCount() const
+    {
+        return m_list.count();
+    }
+
     void remove(int index)
     {
         m_list.removeAt(index);
@@ -122,6 +214,13 @@ public:
         emit dataChanged(QUuid(), QVariantList(), index, 1);
     }
 
+    void removeRange(int index, int count)
+    {
+        m_list.erase(m_list.begin() + index, m_list.begin() + index + count);
+
+        emit dataChanged(QUuid(), QVariantList(), index, count);
+    }
+
     void move(int currentIndex, int newIndex)
     {
         int min = qMin(currentIndex, newIndex);
@@ -135,13 +234,30 @@ public:
         emit dataChanged(QUuid(), variantLIst, min, max - min + 1);
     }
 
+    void update(int index, const QList<QIviStandardItem> &items)
+    {
+        QVariantList variantList;
+        for (int i = 0; i < items.count(); i++) {
+            m_list.replace(index + i, items.at(i));
+            variantList.append(QVariant::fromValue(items.at(i)));
+        }
+
+        emit dataChanged(QUuid(), variantList, index, items.count());
+    }
+
 Q_SIGNALS:
     void registerInstanceCalled(const QUuid &identifier);
     void unregisterInstanceCalled(const QUuid &identifier);
 
 private:
     QList<QIviStandardItem> m_list;
+    QString m_instanceDataName;
+    QHash<QUuid, QList<QIviStandardItem>> m_instanceLists;
     QtIviCoreModule::ModelCapabilities m_caps;
+    bool m_deferReplies = false;
+    QList<std::function<void()>> m_pendingReplies;
+    QList<int> m_cancelledFetches;
+    bool m_cancelFetchResult = false;
 };
 
 class TestServiceObject : public QIviServiceObject
@@ -191,6 +307,7 @@ public:
     tst_QIviPagingModel();
 
 private Q_SLOTS:
+    void initTestCase();
     void cleanup();
 
     void testClearServiceObject();
@@ -203,7 +320,22 @@ private Q_SLOTS:
     void testDataChangedMode();
     void testReload();
     void testDataChangedMode_jump();
+    void testCacheLimit();
+    void testPrefetch();
+    void testPendingFetches();
+    void testPendingFetches_emptyReply();
+    void testPendingFetches_cancelled();
+    void testAdaptiveChunkSize();
+    void testSnapshot();
+    void testSharedCache();
+    void testSharedCache_statefulBackend();
+    void testIncrementalReload();
+    void testIncrementalReload_shrink();
+    void testBackgroundDecoding();
+    void testStatistics();
     void testEditing();
+    void testEditing_moveDetection();
+    void testBulkRemove();
     void testMissingCapabilities();
 
 private:
@@ -215,6 +347,11 @@ tst_QIviPagingModel::tst_QIviPagingModel()
 {
 }
 
+void tst_QIviPagingModel::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+}
+
 void tst_QIviPagingModel::cleanup()
 {
     manager->unloadAllBackends();
@@ -492,6 +629,643 @@ void tst_QIviPagingModel::testDataChangedMode_jump()
     QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), chunkBegin);
 }
 
+void tst_QIviPagingModel::testCacheLimit()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setFetchMoreThreshold(0);
+
+    QSignalSpy cacheLimitSpy(&model, &QIviPagingModel::cacheLimitChanged);
+    model.setCacheLimit(2);
+    QCOMPARE(model.cacheLimit(), 2);
+    QCOMPARE(cacheLimitSpy.count(), 1);
+
+    model.setServiceObject(service);
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(model.rowCount(), 100);
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+
+    // The second chunk isn't cached yet and needs to be fetched first
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    QVERIFY(!model.get(15).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(model.at<QIviStandardItem>(15).id(), QLatin1String("simple 15"));
+    QCOMPARE(fetchDataSpy.count(), 1);
+
+    // Fetching a third chunk evicts the least recently used one
+    QCOMPARE(model.at<QIviStandardItem>(25).id(), QString());
+    QCOMPARE(model.at<QIviStandardItem>(25).id(), QLatin1String("simple 25"));
+    QCOMPARE(fetchDataSpy.count(), 2);
+
+    QCOMPARE(model.at<QIviStandardItem>(15).id(), QLatin1String("simple 15"));
+    QCOMPARE(fetchDataSpy.count(), 2);
+
+    // The evicted chunk is fetched again on the next access
+    fetchDataSpy.clear();
+    QVERIFY(!model.get(5).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+
+    // Lowering the limit evicts the chunks immediately
+    model.setCacheLimit(1);
+    fetchDataSpy.clear();
+    QVERIFY(!model.get(15).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+}
+
+void tst_QIviPagingModel::testPrefetch()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    auto fetchedChunks = [&fetchDataSpy]() {
+        QList<int> starts;
+        for (const QList<QVariant> &args : qAsConst(fetchDataSpy))
+            starts.append(args.at(2).toInt());
+        fetchDataSpy.clear();
+        return starts;
+    };
+
+    // The viewport is inferred from the requested rows
+    {
+        QIviPagingModel model;
+        model.setChunkSize(10);
+        model.setFetchMoreThreshold(0);
+        model.setPrefetchDistance(1);
+        model.setServiceObject(service);
+        model.setLoadingType(QIviPagingModel::DataChanged);
+        QCOMPARE(model.rowCount(), 100);
+        fetchDataSpy.clear();
+
+        QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+        QCOMPARE(fetchedChunks(), QList<int>({10}));
+
+        QCOMPARE(model.at<QIviStandardItem>(15).id(), QLatin1String("simple 15"));
+        QCOMPARE(fetchedChunks(), QList<int>({20}));
+
+        // Skipping chunks doubles the prefetch distance
+        QVERIFY(!model.get(45).isValid());
+        QCOMPARE(fetchedChunks(), QList<int>({40, 50, 60, 30}));
+    }
+
+    // Explicitly set viewport
+    {
+        QIviPagingModel model;
+        model.setChunkSize(10);
+        model.setFetchMoreThreshold(0);
+        model.setPrefetchDistance(2);
+        model.setServiceObject(service);
+        model.setLoadingType(QIviPagingModel::DataChanged);
+        QCOMPARE(model.rowCount(), 100);
+        fetchDataSpy.clear();
+
+        model.setViewport(20, 29);
+        QCOMPARE(fetchedChunks(), QList<int>({20, 30, 40, 10}));
+
+        // Everything around the new viewport is already available
+        model.setViewport(10, 19);
+        QCOMPARE(fetchedChunks(), QList<int>());
+
+        model.setViewport(70, 79);
+        QCOMPARE(fetchedChunks(), QList<int>({70, 80, 90, 60}));
+
+        QIviPagingModelPrivate *d = static_cast<QIviPagingModelPrivate *>(QObjectPrivate::get(&model));
+        const quint64 hits = d->m_cacheHits;
+        const quint64 misses = d->m_cacheMisses;
+        QCOMPARE(model.at<QIviStandardItem>(85).id(), QLatin1String("simple 85"));
+        QCOMPARE(d->m_cacheHits, hits + 1);
+        QVERIFY(!model.get(55).isValid());
+        QCOMPARE(d->m_cacheMisses, misses + 1);
+
+        QTest::ignoreMessage(QtWarningMsg, "The provided viewport is invalid. This call will have no effect");
+        model.setViewport(10, 5);
+    }
+}
+
+void tst_QIviPagingModel::testPendingFetches()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setServiceObject(service);
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(model.rowCount(), 100);
+
+    QIviPagingModelPrivate *d = static_cast<QIviPagingModelPrivate *>(QObjectPrivate::get(&model));
+    service->testBackend()->setDeferReplies(true);
+
+    // Requesting the same chunk again while it is still on its way is coalesced
+    QVERIFY(!model.get(55).isValid());
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 1);
+    d->fetchData(50);
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 1);
+
+    // The late reply for the request issued before the reset is dropped
+    QSignalSpy dataChangedSpy(&model, SIGNAL(dataChanged(const QModelIndex, const QModelIndex, const QVector<int>)));
+    model.reload();
+    QCOMPARE(service->testBackend()->cancelledFetches(), QList<int>({50}));
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 2);
+    // Only the request of the current query is pending, the outdated one is only tracked
+    QCOMPARE(d->m_pendingFetches.count(), 2);
+    QCOMPARE(d->pendingFetchCount(), 1);
+
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 0);
+    QVERIFY(d->m_pendingFetches.isEmpty());
+
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+    QVERIFY(!model.get(55).isValid());
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 1);
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(model.at<QIviStandardItem>(55).id(), QLatin1String("simple 55"));
+}
+
+void tst_QIviPagingModel::testPendingFetches_emptyReply()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setServiceObject(service);
+    QCOMPARE(model.rowCount(), 10);
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    // The data ends exactly at the chunk boundary and the next chunk is answered without rows
+    while (service->testBackend()->rowCount() > 10)
+        service->testBackend()->removeSilently(10);
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 10);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    // The request isn't pending anymore
+    QIviPagingModelPrivate *d = static_cast<QIviPagingModelPrivate *>(QObjectPrivate::get(&model));
+    QVERIFY(d->m_pendingFetches.isEmpty());
+    QCOMPARE(model.statistics().pendingFetches(), 0);
+
+    // The same chunk can be requested again once new data is available
+    QIviStandardItem newItem;
+    newItem.setId(QLatin1String("new"));
+    service->testBackend()->insertSilently(10, newItem);
+    d->fetchData(10);
+    QCOMPARE(model.rowCount(), 11);
+    QCOMPARE(model.at<QIviStandardItem>(10).id(), QLatin1String("new"));
+}
+
+void tst_QIviPagingModel::testPendingFetches_cancelled()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setServiceObject(service);
+    QCOMPARE(model.rowCount(), 10);
+
+    // The backend claims to abort the request, but answers it nonetheless
+    service->testBackend()->setDeferReplies(true);
+    service->testBackend()->setCancelFetchResult(true);
+    model.fetchMore(QModelIndex());
+    model.reload();
+    QCOMPARE(service->testBackend()->cancelledFetches(), QList<int>({10}));
+    QCOMPARE(model.rowCount(), 0);
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 2);
+
+    // The late reply isn't applied to the reset model
+    service->testBackend()->sendPendingReplies(1);
+    QCOMPARE(model.rowCount(), 0);
+
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(model.rowCount(), 10);
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+    QIviPagingModelPrivate *d = static_cast<QIviPagingModelPrivate *>(QObjectPrivate::get(&model));
+    QVERIFY(d->m_pendingFetches.isEmpty());
+}
+
+void tst_QIviPagingModel::testAdaptiveChunkSize()
+{
+    QIviPagingModel model;
+    QIviPagingModelPrivate *d = static_cast<QIviPagingModelPrivate *>(QObjectPrivate::get(&model));
+    QSignalSpy chunkSizeSpy(&model, &QIviPagingModel::chunkSizeChanged);
+
+    // A remote backend with a high latency per request
+    d->addFetchSample(30, 83000000);
+    d->addFetchSample(20, 82000000);
+    d->addFetchSample(40, 84000000);
+    d->addFetchSample(10, 81000000);
+    QVERIFY(qAbs(model.fetchLatency() - 80) < 0.001);
+    QVERIFY(qAbs(model.rowFetchCost() - 0.1) < 0.001);
+
+    // Nothing changes until the adaptive mode is enabled
+    d->adaptChunkSize();
+    QCOMPARE(chunkSizeSpy.count(), 0);
+
+    model.setAdaptiveChunkSize(true);
+    d->adaptChunkSize();
+    QCOMPARE(model.chunkSize(), 200);
+
+    model.setMaximumChunkSize(100);
+    d->adaptChunkSize();
+    QCOMPARE(model.chunkSize(), 100);
+
+    // A local backend which is cheap per request
+    d->m_fetchSamples.clear();
+    d->addFetchSample(30, 2500000);
+    d->addFetchSample(20, 2000000);
+    d->addFetchSample(40, 3000000);
+    d->addFetchSample(10, 1500000);
+    QVERIFY(qAbs(model.fetchLatency() - 1) < 0.001);
+    QVERIFY(qAbs(model.rowFetchCost() - 0.05) < 0.001);
+    d->adaptChunkSize();
+    QCOMPARE(model.chunkSize(), 20);
+
+    // Small changes are ignored
+    model.setMinimumChunkSize(22);
+    d->adaptChunkSize();
+    QCOMPARE(model.chunkSize(), 20);
+    model.setMinimumChunkSize(50);
+    d->adaptChunkSize();
+    QCOMPARE(model.chunkSize(), 50);
+}
+
+void tst_QIviPagingModel::testSnapshot()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    QDir snapshotDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + QLatin1String("/qtivi/pagingmodel"));
+    snapshotDir.removeRecursively();
+
+    {
+        QIviPagingModel model;
+        model.setChunkSize(10);
+        model.setSnapshotChunkCount(2);
+        model.setServiceObject(service);
+        QCOMPARE(model.rowCount(), 10);
+        QCOMPARE(model.at<QIviStandardItem>(9).id(), QLatin1String("simple 9"));
+        QCOMPARE(model.rowCount(), 20);
+        // The snapshot is written delayed, collecting the fetched chunks
+        QCOMPARE(snapshotDir.entryList(QDir::Files).count(), 0);
+    }
+    // Pending snapshot writes are started when the model gets deleted and finish in the background
+    QTRY_COMPARE(snapshotDir.entryList(QDir::Files).count(), 1);
+
+    QIviStandardItem changedItem;
+    changedItem.setId(QLatin1String("changed"));
+    service->testBackend()->replaceSilently(3, changedItem);
+    service->testBackend()->setDeferReplies(true);
+
+    // The rows are restored from the snapshot before the backend replied
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setSnapshotChunkCount(2);
+    model.setServiceObject(service);
+    QCOMPARE(model.rowCount(), 20);
+    QCOMPARE(model.at<QIviStandardItem>(3).id(), QLatin1String("simple 3"));
+    QCOMPARE(model.at<QIviStandardItem>(15).id(), QLatin1String("simple 15"));
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 2);
+
+    // Only the changed row is updated once the fresh data arrives
+    QSignalSpy resetSpy(&model, SIGNAL(modelReset()));
+    QSignalSpy dataChangedSpy(&model, SIGNAL(dataChanged(const QModelIndex, const QModelIndex, const QVector<int>)));
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 3);
+    QCOMPARE(dataChangedSpy.at(0).at(1).toModelIndex().row(), 3);
+    QCOMPARE(model.at<QIviStandardItem>(3).id(), QLatin1String("changed"));
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    snapshotDir.removeRecursively();
+}
+
+void tst_QIviPagingModel::testSharedCache()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsSharedResults);
+    service->testBackend()->initializeSimpleData();
+    service->testBackend()->setDeferReplies(true);
+
+    QIviPagingModel first;
+    first.setSharedCache(true);
+    first.setChunkSize(10);
+    first.setServiceObject(service);
+
+    QIviPagingModel second;
+    second.setSharedCache(true);
+    second.setChunkSize(10);
+    second.setServiceObject(service);
+
+    // The chunk requested by the first model is not requested again
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 1);
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(first.rowCount(), 10);
+    QCOMPARE(second.rowCount(), 10);
+    QCOMPARE(second.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+
+    // A model created later gets the already fetched chunk right away
+    QIviPagingModel third;
+    third.setSharedCache(true);
+    third.setChunkSize(10);
+    third.setServiceObject(service);
+    QCOMPARE(third.rowCount(), 10);
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 0);
+
+    // Every model keeps its own rows
+    first.fetchMore(QModelIndex());
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 1);
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(first.rowCount(), 20);
+    QCOMPARE(second.rowCount(), 10);
+    third.fetchMore(QModelIndex());
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 0);
+    QCOMPARE(third.rowCount(), 20);
+    QCOMPARE(third.at<QIviStandardItem>(15).id(), QLatin1String("simple 15"));
+
+    // A waiting model requests the chunk itself once the requesting model got reset
+    first.fetchMore(QModelIndex());
+    second.fetchMore(QModelIndex());
+    second.fetchMore(QModelIndex());
+    QCOMPARE(second.rowCount(), 20);
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 1);
+    first.reload();
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 3);
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(first.rowCount(), 10);
+    QCOMPARE(second.rowCount(), 30);
+    QCOMPARE(second.at<QIviStandardItem>(25).id(), QLatin1String("simple 25"));
+
+    // Models with a different chunk size can't share the chunks
+    QIviPagingModel fourth;
+    fourth.setSharedCache(true);
+    fourth.setServiceObject(service);
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 1);
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(fourth.rowCount(), 30);
+}
+
+void tst_QIviPagingModel::testSharedCache_statefulBackend()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+    service->testBackend()->setDeferReplies(true);
+
+    QIviPagingModel first;
+    first.setSharedCache(true);
+    first.setChunkSize(10);
+    first.setServiceObject(service);
+
+    // The backend doesn't report SupportsSharedResults and answers the second instance differently
+    service->testBackend()->setInstanceData(QLatin1String("second"));
+    QIviPagingModel second;
+    second.setSharedCache(true);
+    second.setChunkSize(10);
+    second.setServiceObject(service);
+
+    // Every model requests its data itself
+    QCOMPARE(service->testBackend()->pendingReplyCount(), 2);
+    service->testBackend()->sendPendingReplies();
+    QCOMPARE(first.rowCount(), 10);
+    QCOMPARE(second.rowCount(), 10);
+    QCOMPARE(first.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+    QCOMPARE(second.at<QIviStandardItem>(5).id(), QLatin1String("second 5"));
+}
+
+void tst_QIviPagingModel::testIncrementalReload()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setIncrementalReload(true);
+    model.setServiceObject(service);
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 20);
+    model.setViewport(0, 15);
+
+    // Change the data while the model is not informed, e.g. after the media was reindexed
+    TestBackend *backend = service->testBackend();
+    backend->removeSilently(2);
+    QIviStandardItem newItem;
+    newItem.setId(QLatin1String("new"));
+    backend->insertSilently(5, newItem);
+    backend->moveSilently(12, 0);
+    QIviStandardItem changedItem = backend->itemAt(4);
+    changedItem.setData(QVariantMap({{QLatin1String("changed"), true}}));
+    backend->replaceSilently(4, changedItem);
+
+    QSignalSpy resetSpy(&model, SIGNAL(modelReset()));
+    QSignalSpy removedSpy(&model, SIGNAL(rowsRemoved(const QModelIndex &, int , int )));
+    QSignalSpy insertedSpy(&model, SIGNAL(rowsInserted(const QModelIndex &, int , int )));
+    QSignalSpy movedSpy(&model, SIGNAL(rowsMoved(const QModelIndex &, int , int , const QModelIndex &, int )));
+    QSignalSpy dataChangedSpy(&model, SIGNAL(dataChanged(const QModelIndex, const QModelIndex, const QVector<int>)));
+
+    // Only the differences are reported to the view
+    model.reload();
+    QCOMPARE(resetSpy.count(), 0);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 2);
+    QCOMPARE(movedSpy.count(), 1);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(insertedSpy.at(0).at(1).toInt(), 6);
+    QCOMPARE(dataChangedSpy.count(), 1);
+    QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 4);
+
+    QCOMPARE(model.rowCount(), 20);
+    for (int i = 0; i < model.rowCount(); i++)
+        QCOMPARE(model.at<QIviStandardItem>(i).id(), backend->itemAt(i).id());
+    QVERIFY(model.canFetchMore(QModelIndex()));
+
+    // Changing the loading type always resets the model
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(model.rowCount(), 100);
+}
+
+void tst_QIviPagingModel::testIncrementalReload_shrink()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+    TestBackend *backend = service->testBackend();
+
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setIncrementalReload(true);
+    model.setServiceObject(service);
+    model.fetchMore(QModelIndex());
+    model.fetchMore(QModelIndex());
+    QCOMPARE(model.rowCount(), 30);
+    model.setViewport(0, 25);
+
+    // The third chunk doesn't exist anymore and the backend never answers it
+    while (backend->rowCount() > 15)
+        backend->removeSilently(15);
+    QCOMPARE(backend->rowCount(), 15);
+
+    backend->setDeferReplies(true);
+    model.reload();
+    QCOMPARE(backend->pendingReplyCount(), 3);
+    backend->sendPendingReplies(2);
+    QCOMPARE(model.rowCount(), 15);
+    for (int i = 0; i < model.rowCount(); i++)
+        QCOMPARE(model.at<QIviStandardItem>(i).id(), backend->itemAt(i).id());
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+    QVERIFY(backend->cancelledFetches().contains(20));
+
+    // The late reply is discarded and the following signals are handled again
+    backend->sendPendingReplies();
+    QCOMPARE(model.rowCount(), 15);
+    backend->setDeferReplies(false);
+    QIviStandardItem newItem;
+    newItem.setId(QLatin1String("new"));
+    backend->insert(0, newItem);
+    QCOMPARE(model.rowCount(), 16);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QLatin1String("new"));
+
+    // Without a count, an empty chunk marks the end of the data
+    backend->setCapabilities(QtIviCoreModule::NoExtras);
+    while (backend->rowCount() > 10)
+        backend->removeSilently(10);
+    model.reload();
+    QCOMPARE(model.rowCount(), 10);
+    for (int i = 0; i < model.rowCount(); i++)
+        QCOMPARE(model.at<QIviStandardItem>(i).id(), backend->itemAt(i).id());
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+}
+
+void tst_QIviPagingModel::testBackgroundDecoding()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setFetchMoreThreshold(0);
+    model.setBackgroundDecoding(true);
+    QSignalSpy insertedSpy(&model, SIGNAL(rowsInserted(const QModelIndex &, int , int )));
+    model.setServiceObject(service);
+
+    // The rows are inserted once the chunk got decoded on the worker thread
+    QCOMPARE(model.rowCount(), 0);
+    QTRY_COMPARE(model.rowCount(), 10);
+    QCOMPARE(insertedSpy.count(), 1);
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+
+    model.fetchMore(QModelIndex());
+    QTRY_COMPARE(model.rowCount(), 20);
+    QCOMPARE(model.at<QIviStandardItem>(15).id(), QLatin1String("simple 15"));
+
+    QIviPagingModelPrivate *d = static_cast<QIviPagingModelPrivate *>(QObjectPrivate::get(&model));
+    QCOMPARE(d->m_decodedChunkCount, quint64(2));
+    QVERIFY(d->m_decodeHandOffTime > 0);
+    QCOMPARE(d->m_pendingDecodes, 0);
+}
+
+void tst_QIviPagingModel::testStatistics()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize);
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setChunkSize(10);
+    model.setFetchMoreThreshold(0);
+    model.setCacheLimit(2);
+    model.setStatisticsEnabled(true);
+    model.setServiceObject(service);
+    model.setLoadingType(QIviPagingModel::DataChanged);
+    QCOMPARE(model.rowCount(), 100);
+
+    QIviPagingModelStatistics statistics = model.statistics();
+    const quint64 fetchCount = statistics.fetchCount();
+    QVERIFY(fetchCount > 0);
+    QCOMPARE(statistics.pendingFetches(), 0);
+    QCOMPARE(statistics.rowCount(), 100);
+    QCOMPARE(statistics.cachedRowCount(), 10);
+    QCOMPARE(statistics.cachedChunkCount(), 1);
+    QCOMPARE(statistics.fetchLatencyHistogram().count(), statistics.fetchLatencyBuckets().count() + 1);
+    int histogramCount = 0;
+    for (int count : statistics.fetchLatencyHistogram())
+        histogramCount += count;
+    QCOMPARE(quint64(histogramCount), fetchCount);
+
+    // The change signal is emitted once for all accesses within the same event loop iteration
+    QSignalSpy statisticsSpy(&model, &QIviPagingModel::statisticsChanged);
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+    QCOMPARE(model.data(model.index(5, 0), QIviPagingModel::NameRole).toString(), QLatin1String("simple 5"));
+    QVERIFY(!model.get(15).isValid());
+    QVERIFY(!model.get(25).isValid());
+    QCOMPARE(model.at<QIviStandardItem>(25).id(), QLatin1String("simple 25"));
+    QVERIFY(statisticsSpy.isEmpty());
+    QTRY_COMPARE(statisticsSpy.count(), 1);
+
+    // Fetching the third chunk evicted the first one
+    statistics = model.statistics();
+    QCOMPARE(statistics.cacheHits(), quint64(3));
+    QCOMPARE(statistics.cacheMisses(), quint64(2));
+    QCOMPARE(statistics.roleCacheHits().value(QStringLiteral("item")).toInt(), 2);
+    QCOMPARE(statistics.roleCacheHits().value(QStringLiteral("name")).toInt(), 1);
+    QCOMPARE(statistics.roleCacheMisses().value(QStringLiteral("item")).toInt(), 2);
+    QCOMPARE(statistics.fetchCount(), fetchCount + 2);
+    QCOMPARE(statistics.cachedRowCount(), 20);
+    QCOMPARE(statistics.cachedChunkCount(), 2);
+    QCOMPARE(statistics.evictedChunkCount(), quint64(1));
+
+    // The statistics are a snapshot and not updated afterwards
+    model.get(5);
+    QCOMPARE(statistics.cacheMisses(), quint64(2));
+    QCOMPARE(model.statistics().cacheMisses(), quint64(3));
+
+    // Resetting the model resets the statistics as well
+    statisticsSpy.clear();
+    model.setServiceObject(nullptr);
+    QVERIFY(statisticsSpy.count() > 0);
+    statistics = model.statistics();
+    QCOMPARE(statistics.cacheHits(), quint64(0));
+    QCOMPARE(statistics.cacheMisses(), quint64(0));
+    QVERIFY(statistics.roleCacheHits().isEmpty());
+    QCOMPARE(statistics.fetchCount(), quint64(0));
+    QCOMPARE(statistics.evictedChunkCount(), quint64(0));
+    QCOMPARE(statistics.rowCount(), 0);
+
+    // The cache accesses are not counted by default
+    QVERIFY(!model.statisticsEnabled());
+    model.setServiceObject(service);
+    statisticsSpy.clear();
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 5"));
+    QCoreApplication::processEvents();
+    QVERIFY(statisticsSpy.isEmpty());
+    QCOMPARE(model.statistics().cacheHits(), quint64(0));
+    QCOMPARE(model.statistics().fetchCount(), quint64(1));
+}
+
 void tst_QIviPagingModel::testEditing()
 {
     TestServiceObject *service = new TestServiceObject();
@@ -516,13 +1290,25 @@ void tst_QIviPagingModel::testEditing()
     QCOMPARE(model.at<QIviStandardItem>(0).id(), newItem.id());
 
     // Move the item to a new location
-    QSignalSpy moveSpy(&model, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &, const QVector<int> &)));
+    QSignalSpy moveSpy(&model, SIGNAL(rowsMoved(const QModelIndex &, int, int, const QModelIndex &, int)));
     int newIndex = 10;
     service->testBackend()->move(0, newIndex);
-    QVERIFY(moveSpy.count());
-    QCOMPARE(moveSpy.at(0).at(0).toModelIndex().row(), 0);
-    QCOMPARE(moveSpy.at(0).at(1).toModelIndex().row(), newIndex);
+    QCOMPARE(moveSpy.count(), 1);
+    QCOMPARE(moveSpy.at(0).at(1).toInt(), 0);
+    QCOMPARE(moveSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(moveSpy.at(0).at(4).toInt(), newIndex + 1);
+
+    QCOMPARE(model.at<QIviStandardItem>(newIndex).id(), newItem.id());
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QLatin1String("simple 0"));
 
+    // Move the item up again
+    moveSpy.clear();
+    service->testBackend()->move(newIndex, 5);
+    QCOMPARE(moveSpy.count(), 1);
+    QCOMPARE(moveSpy.at(0).at(1).toInt(), newIndex);
+    QCOMPARE(moveSpy.at(0).at(4).toInt(), 5);
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), newItem.id());
+    service->testBackend()->move(5, newIndex);
     QCOMPARE(model.at<QIviStandardItem>(newIndex).id(), newItem.id());
 
     // Remove the item again
@@ -535,6 +1321,77 @@ void tst_QIviPagingModel::testEditing()
     QCOMPARE(model.at<QIviStandardItem>(newIndex).id(), QLatin1String("simple 10"));
 }
 
+void tst_QIviPagingModel::testEditing_moveDetection()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    //Two rows share the same id
+    QIviStandardItem first;
+    first.setId(QLatin1String("duplicate"));
+    first.setData(QVariantMap{{"content", "first"}});
+    QIviStandardItem second;
+    second.setId(QLatin1String("duplicate"));
+    second.setData(QVariantMap{{"content", "second"}});
+    service->testBackend()->replaceSilently(0, first);
+    service->testBackend()->replaceSilently(1, second);
+
+    QIviPagingModel model;
+    model.setServiceObject(service);
+    QCOMPARE(model.at<QIviStandardItem>(0).data().value("content").toString(), QLatin1String("first"));
+
+    QSignalSpy moveSpy(&model, SIGNAL(rowsMoved(const QModelIndex &, int, int, const QModelIndex &, int)));
+    QSignalSpy changedSpy(&model, SIGNAL(dataChanged(const QModelIndex &, const QModelIndex &, const QVector<int> &)));
+
+    //Swapping rows with the same id can't be detected as a move, both rows changed instead
+    service->testBackend()->update(0, {second, first});
+    QCOMPARE(moveSpy.count(), 0);
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.at(0).at(0).toModelIndex().row(), 0);
+    QCOMPARE(changedSpy.at(0).at(1).toModelIndex().row(), 1);
+    QCOMPARE(model.at<QIviStandardItem>(0).data().value("content").toString(), QLatin1String("second"));
+    QCOMPARE(model.at<QIviStandardItem>(1).data().value("content").toString(), QLatin1String("first"));
+
+    //A moved row which changed its content as well
+    moveSpy.clear();
+    changedSpy.clear();
+    QIviStandardItem moved = service->testBackend()->itemAt(2);
+    moved.setData(QVariantMap{{"content", "changed"}});
+    const QIviStandardItem next = service->testBackend()->itemAt(3);
+    service->testBackend()->update(2, {next, moved});
+    QCOMPARE(moveSpy.count(), 1);
+    QCOMPARE(moveSpy.at(0).at(1).toInt(), 2);
+    QCOMPARE(moveSpy.at(0).at(4).toInt(), 4);
+    QCOMPARE(changedSpy.count(), 1);
+    QCOMPARE(changedSpy.at(0).at(0).toModelIndex().row(), 3);
+    QCOMPARE(changedSpy.at(0).at(1).toModelIndex().row(), 3);
+    QCOMPARE(model.at<QIviStandardItem>(3).id(), moved.id());
+    QCOMPARE(model.at<QIviStandardItem>(3).data().value("content").toString(), QLatin1String("changed"));
+}
+
+void tst_QIviPagingModel::testBulkRemove()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    QIviPagingModel model;
+    model.setServiceObject(service);
+    QCOMPARE(model.rowCount(), model.chunkSize());
+
+    QSignalSpy removedSpy(&model, SIGNAL(rowsRemoved(const QModelIndex &, int , int )));
+    service->testBackend()->removeRange(5, 10);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(removedSpy.at(0).at(1).toInt(), 5);
+    QCOMPARE(removedSpy.at(0).at(2).toInt(), 14);
+
+    QCOMPARE(model.rowCount(), model.chunkSize() - 10);
+    QCOMPARE(model.at<QIviStandardItem>(4).id(), QLatin1String("simple 4"));
+    QCOMPARE(model.at<QIviStandardItem>(5).id(), QLatin1String("simple 15"));
+    QCOMPARE(model.at<QIviStandardItem>(model.rowCount() - 1).id(), QLatin1String("simple 29"));
+}
+
 void tst_QIviPagingModel::testMissingCapabilities()
 {
     TestServiceObject *service = new TestServiceObject();
@@ -64,6 +64,17 @@ public:
             m_lists.insert(type, createItemList(type));
     }
 
+    //Removes the items at the end of a data set without informing the models
+    void truncateData(const QString &contentType, int count)
+    {
+        m_lists[contentType] = m_lists.value(contentType).mid(0, count);
+    }
+
+    QIviAbstractQueryTerm *filterTerm() const
+    {
+        return m_filterTerm;
+    }
+
     //Adds a data set which can be filtered and sorted
     void initializeFilterData()
     {
@@ -216,6 +227,14 @@ public:
         if (m_caps.testFlag(QtIviCoreModule::SupportsGetSize))
             emit countChanged(identifier, list.count());
 
+        //Every ten rows form a section
+        if (m_caps.testFlag(QtIviCoreModule::SupportsSectionIndex) && start == 0) {
+            QVariantList sections;
+            for (int i = 0; i < list.count(); i += 10)
+                sections.append(QVariantMap{{"section", QString::number(i / 10)}, {"index", i}});
+            emit sectionsChanged(identifier, sections);
+        }
+
         QVariantList requestedItems;
 
         int size = qMin(start + count, list.count());
@@ -394,8 +413,14 @@ private Q_SLOTS:
     void testDataChangedMode_jump();
     void testNavigation_data();
     void testNavigation();
+    void testNavigationHistory();
+    void testPrefetchChildren();
+    void testSections();
     void testFilter_data();
     void testFilter();
+    void testQueryCache();
+    void testLocalQuery();
+    void testQueryDelay();
     void testEditing();
     void testIndexOf_qml();
     void testInputErrors();
@@ -805,6 +830,128 @@ void tst_QIviSearchAndBrowseModel::testNavigation()
     qDeleteAll(modelStack);
 }
 
+void tst_QIviSearchAndBrowseModel::testNavigationHistory()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeNavigationData();
+
+    QIviSearchAndBrowseModel model;
+    model.setServiceObject(service);
+    model.setContentType("levelOne");
+    QCOMPARE(model.rowCount(), model.chunkSize());
+    model.setViewport(5, 8);
+
+    QVERIFY(!model.goForward(1, QIviSearchAndBrowseModel::InModelNavigation));
+    QCOMPARE(model.contentType(), QLatin1String("levelTwo"));
+    QCOMPARE(model.at<QIviStandardItem>(1).id(), QLatin1String("levelTwo ") + QString::number(1));
+
+    // Going back shows the previous level right away and revalidates the restored rows
+    QSignalSpy positionRestoredSpy(&model, SIGNAL(positionRestored(int)));
+    QSignalSpy resetSpy(&model, SIGNAL(modelReset()));
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    model.goBack();
+    QCOMPARE(model.contentType(), QLatin1String("levelOne"));
+    QCOMPARE(positionRestoredSpy.count(), 1);
+    QCOMPARE(positionRestoredSpy.at(0).at(0).toInt(), 5);
+    QCOMPARE(resetSpy.count(), 1);
+    QCOMPARE(model.rowCount(), model.chunkSize());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), 0);
+    QVERIFY(model.canGoForward(1));
+    QCOMPARE(model.at<QIviStandardItem>(1).id(), QLatin1String("levelOne ") + QString::number(1));
+    QCOMPARE(fetchDataSpy.count(), 1);
+
+    // The rows which got removed in the meantime are removed from the restored level as well
+    QVERIFY(!model.goForward(1, QIviSearchAndBrowseModel::InModelNavigation));
+    service->testBackend()->truncateData("levelOne", 5);
+    QSignalSpy rowsRemovedSpy(&model, SIGNAL(rowsRemoved(const QModelIndex &, int, int)));
+    model.goBack();
+    QCOMPARE(model.contentType(), QLatin1String("levelOne"));
+    QCOMPARE(model.rowCount(), 5);
+    QCOMPARE(rowsRemovedSpy.count(), 1);
+    QCOMPARE(rowsRemovedSpy.at(0).at(1).toInt(), 5);
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    // Changing the content type discards the history
+    QVERIFY(!model.goForward(1, QIviSearchAndBrowseModel::InModelNavigation));
+    model.setContentType("levelThree");
+    model.setContentType("levelTwo");
+    positionRestoredSpy.clear();
+    model.goBack();
+    QCOMPARE(model.contentType(), QLatin1String("levelOne"));
+    QVERIFY(!positionRestoredSpy.count());
+}
+
+void tst_QIviSearchAndBrowseModel::testPrefetchChildren()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsStatelessNavigation);
+    service->testBackend()->initializeNavigationData();
+
+    QIviSearchAndBrowseModel model;
+    model.setServiceObject(service);
+    QSignalSpy prefetchChildrenSpy(&model, SIGNAL(prefetchChildrenChanged(bool)));
+    model.setPrefetchChildren(true);
+    QVERIFY(model.prefetchChildren());
+    QCOMPARE(prefetchChildrenSpy.count(), 1);
+
+    model.setContentType("levelOne");
+    QCOMPARE(model.rowCount(), model.chunkSize());
+
+    // The first chunk of the next level is fetched for the visible row in the background
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    model.setViewport(1, 1);
+    QTRY_COMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(1).value<QList<QVariant>>().at(1).value<QIviStandardItem>().id(), QLatin1String("levelTwo ") + QString::number(1));
+
+    // Going forward hands out the prefetched model without fetching the data again
+    QScopedPointer<QIviSearchAndBrowseModel> childModel(model.goForward(1, QIviSearchAndBrowseModel::OutOfModelNavigation));
+    QVERIFY(childModel);
+    QVERIFY(!childModel->parent());
+    QCOMPARE(childModel->contentType(), QLatin1String("levelTwo"));
+    QCOMPARE(childModel->rowCount(), childModel->chunkSize());
+    QCOMPARE(childModel->at<QIviStandardItem>(1).id(), QLatin1String("levelTwo ") + QString::number(1));
+    QCOMPARE(fetchDataSpy.count(), 1);
+}
+
+void tst_QIviSearchAndBrowseModel::testSections()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::SupportsGetSize | QtIviCoreModule::SupportsSectionIndex);
+    service->testBackend()->initializeSimpleData();
+
+    QIviSearchAndBrowseModel model;
+    model.setServiceObject(service);
+    model.setLoadingType(QIviPagingModel::DataChanged);
+
+    QSignalSpy sectionsChangedSpy(&model, SIGNAL(sectionsChanged(const QVariantList &)));
+    model.setContentType("simple");
+    QCOMPARE(model.rowCount(), 100);
+    QCOMPARE(sectionsChangedSpy.count(), 1);
+    QCOMPARE(model.sections().count(), 10);
+    QCOMPARE(model.sections().at(9).toMap().value("section").toString(), QString("9"));
+    QCOMPARE(model.sections().at(9).toMap().value("index").toInt(), 90);
+
+    // Jumping to a section fetches its rows right away
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    QCOMPARE(model.indexOfSection("9"), 90);
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), int(90 / model.chunkSize()) * model.chunkSize());
+    QCOMPARE(model.at<QIviStandardItem>(90).id(), QLatin1String("simple ") + QString::number(90));
+    QCOMPARE(fetchDataSpy.count(), 1);
+
+    QCOMPARE(model.indexOfSection("10"), -1);
+
+    // The sections of the backend don't match the rows of a local query
+    model.setLocalQuery(true);
+    model.setQuery(QString("id~='simple 1*'"));
+    QTRY_COMPARE(model.rowCount(), 11);
+    QVERIFY(model.sections().isEmpty());
+}
+
 // If more complex queries are added here you also need to make sure the backend can handle it.
 void tst_QIviSearchAndBrowseModel::testFilter_data()
 {
@@ -856,6 +1003,148 @@ void tst_QIviSearchAndBrowseModel::testFilter()
     QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(0));
 }
 
+void tst_QIviSearchAndBrowseModel::testQueryCache()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::ModelCapabilities( QtIviCoreModule::SupportsFiltering |
+                                                                                QtIviCoreModule::SupportsSorting));
+    service->testBackend()->initializeFilterData();
+
+    QIviSearchAndBrowseModel model;
+    model.setServiceObject(service);
+    model.setContentType("filter");
+
+    model.setQuery(QString("id<50[\\id]"));
+    QIviAbstractQueryTerm *term = service->testBackend()->filterTerm();
+    QVERIFY(term);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(49));
+
+    model.setQuery(QString("id>10"));
+    QVERIFY(service->testBackend()->filterTerm() != term);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(11));
+
+    // Switching back to a known query reuses the parsed term
+    model.setQuery(QString("id<50[\\id]"));
+    QCOMPARE(service->testBackend()->filterTerm(), term);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(49));
+
+    // Another model with the same query uses the same term
+    QIviSearchAndBrowseModel otherModel;
+    otherModel.setServiceObject(service);
+    otherModel.setContentType("filter");
+    otherModel.setQuery(QString("id<50[\\id]"));
+    QCOMPARE(service->testBackend()->filterTerm(), term);
+    QCOMPARE(otherModel.at<QIviStandardItem>(0).id(), QString::number(49));
+
+    // Invalid queries are reported every time
+    QTest::ignoreMessage(QtWarningMsg, "Got end of file but expected on of the following types:\n     integer\n     float\nid>\n  ^");
+    model.setQuery(QString("id>"));
+    QTest::ignoreMessage(QtWarningMsg, "Got end of file but expected on of the following types:\n     integer\n     float\nid>\n  ^");
+    otherModel.setQuery(QString("id>"));
+}
+
+void tst_QIviSearchAndBrowseModel::testLocalQuery()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    // The backend can neither filter nor sort
+    service->testBackend()->setCapabilities(QtIviCoreModule::ModelCapabilities( QtIviCoreModule::SupportsRemove |
+                                                                                QtIviCoreModule::SupportsMove));
+    service->testBackend()->initializeFilterData();
+
+    QIviSearchAndBrowseModel model;
+    model.setServiceObject(service);
+    model.setContentType("filter");
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(0));
+
+    QSignalSpy localQueryChangedSpy(&model, SIGNAL(localQueryChanged(bool)));
+    model.setLocalQuery(true);
+    QVERIFY(model.localQuery());
+    QCOMPARE(localQueryChangedSpy.count(), 1);
+
+    // All chunks are fetched, only the matching items are added in the requested order
+    model.setQuery(QString("id~='1*'[\\id]"));
+    QTRY_COMPARE(model.rowCount(), 11);
+    const QStringList expectedIds = { "19", "18", "17", "16", "15", "14", "13", "12", "11", "10", "1" };
+    for (int i = 0; i < expectedIds.count(); i++)
+        QCOMPARE(model.at<QIviStandardItem>(i).id(), expectedIds.at(i));
+    QVERIFY(!model.canFetchMore(QModelIndex()));
+
+    // Equal items keep the order of the backend
+    model.setQuery(QString("id~='*5'[/type]"));
+    QTRY_COMPARE(model.rowCount(), 10);
+    for (int i = 0; i < model.rowCount(); i++)
+        QCOMPARE(model.at<QIviStandardItem>(i).id(), QString::number(i * 10 + 5));
+
+    // Removing an item uses the position of the backend and streams the content again
+    model.remove(1);
+    QTRY_COMPARE(model.rowCount(), 9);
+    QCOMPARE(model.at<QIviStandardItem>(1).id(), QString::number(25));
+
+    QTest::ignoreMessage(QtWarningMsg, "Items can't be moved while the query is evaluated locally");
+    model.move(0, 1);
+
+    // Without the local query the backend is asked to filter
+    QTest::ignoreMessage(QtWarningMsg, "The backend doesn't support filtering or sorting. Changing the query will have no effect");
+    model.setLocalQuery(false);
+    QTRY_COMPARE(model.rowCount(), 30);
+}
+
+void tst_QIviSearchAndBrowseModel::testQueryDelay()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->setCapabilities(QtIviCoreModule::ModelCapabilities( QtIviCoreModule::SupportsFiltering |
+                                                                                QtIviCoreModule::SupportsSorting));
+    service->testBackend()->initializeFilterData();
+
+    QIviSearchAndBrowseModel model;
+    model.setServiceObject(service);
+    model.setContentType("filter");
+
+    QSignalSpy queryDelayChangedSpy(&model, SIGNAL(queryDelayChanged(int)));
+    model.setQueryDelay(50);
+    QCOMPARE(model.queryDelay(), 50);
+    QCOMPARE(queryDelayChangedSpy.count(), 1);
+
+    // Only the last query is applied, once it didn't change for the delay
+    model.setQuery(QString("id>9"));
+    model.setQuery(QString("id>94"));
+    QCOMPARE(model.query(), QString("id>94"));
+    QVERIFY(!service->testBackend()->filterTerm());
+    QTRY_COMPARE(model.rowCount(), 5);
+    QIviAbstractQueryTerm *term = service->testBackend()->filterTerm();
+    QVERIFY(term);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(95));
+
+    // A narrower query removes the rows which don't match anymore, without asking the backend
+    QSignalSpy resetSpy(&model, SIGNAL(modelReset()));
+    model.setQuery(QString("id>94 & id<98"));
+    QTRY_COMPARE(model.rowCount(), 3);
+    QCOMPARE(service->testBackend()->filterTerm(), term);
+    QCOMPARE(model.at<QIviStandardItem>(2).id(), QString::number(97));
+
+    model.setQuery(QString("id>95 & id<98"));
+    QTRY_COMPARE(model.rowCount(), 2);
+    QCOMPARE(service->testBackend()->filterTerm(), term);
+    QCOMPARE(model.at<QIviStandardItem>(0).id(), QString::number(96));
+    QVERIFY(!resetSpy.count());
+
+    // A wider query is done by the backend again
+    model.setQuery(QString("id>90"));
+    QTRY_COMPARE(model.rowCount(), 9);
+    QVERIFY(service->testBackend()->filterTerm() != term);
+    QCOMPARE(resetSpy.count(), 1);
+
+    // Without a delay the waiting query is applied immediately
+    model.setQuery(QString("id>96"));
+    QCOMPARE(model.rowCount(), 9);
+    model.setQueryDelay(0);
+    QCOMPARE(model.rowCount(), 3);
+    QCOMPARE(queryDelayChangedSpy.count(), 2);
+}
+
 void tst_QIviSearchAndBrowseModel::testEditing()
 {
     TestServiceObject *service = new TestServiceObject();
@@ -31,6 +31,7 @@
 #include <QtCore/QString>
 
 #include "QtIviCore/private/qiviqueryparser_p.h"
+#include "QtIviCore/qiviquerytermevaluator.h"
 
 // sadly this has to be a define for QVERIFY2() to work
 #define CHECK_ERRORSTRING(_actual_errstr, _expected_errstr) do { \
@@ -44,6 +45,22 @@
     } \
 } while (false)
 
+class EvaluatorItem
+{
+    Q_GADGET
+    Q_PROPERTY(QString name MEMBER m_name)
+    Q_PROPERTY(int number MEMBER m_number)
+    Q_PROPERTY(double rating MEMBER m_rating)
+    Q_PROPERTY(bool favorite MEMBER m_favorite)
+
+public:
+    QString m_name;
+    int m_number;
+    double m_rating;
+    bool m_favorite;
+};
+Q_DECLARE_METATYPE(EvaluatorItem)
+
 class TestQueryParser: public QObject
 {
     Q_OBJECT
@@ -56,6 +73,11 @@ private slots:
     void identifierList();
     void invalidIdentifierList_data();
     void invalidIdentifierList();
+    void evaluator_data();
+    void evaluator();
+    void invalidEvaluator();
+    void benchmark_data();
+    void benchmark();
 };
 
 void TestQueryParser::validQueries_data()
@@ -166,6 +188,11 @@ void TestQueryParser::validQueries()
 
     QCOMPARE(term->toString(), newTerm->toString());
     delete newTerm;
+
+    //The in place parser needs to result in the same terms
+    QSharedPointer<QIviAbstractQueryTerm> inPlaceTerm = parser.parse(QStringView(query));
+    QVERIFY2(inPlaceTerm, qPrintable(parser.lastError()));
+    QCOMPARE(inPlaceTerm->toString(), term->toString());
     delete term;
 }
 
@@ -195,6 +222,9 @@ void TestQueryParser::invalidQueries()
 
     QVERIFY(!parser.parse());
     QVERIFY(!parser.lastError().isEmpty());
+
+    QVERIFY(!parser.parse(QStringView(query)));
+    QVERIFY(!parser.lastError().isEmpty());
 }
 
 void TestQueryParser::identifierList_data()
@@ -222,6 +252,8 @@ void TestQueryParser::identifierList()
     QIviAbstractQueryTerm *term = parser.parse();
     QVERIFY2(term, qPrintable(parser.lastError()));
     delete term;
+
+    QVERIFY2(parser.parse(QStringView(query)), qPrintable(parser.lastError()));
 }
 
 void TestQueryParser::invalidIdentifierList_data()
@@ -249,6 +281,150 @@ void TestQueryParser::invalidIdentifierList()
 
     QVERIFY(!parser.parse());
     QVERIFY(!parser.lastError().isEmpty());
+
+    QVERIFY(!parser.parse(QStringView(query)));
+    QVERIFY(!parser.lastError().isEmpty());
+}
+
+static QList<EvaluatorItem> evaluatorItems()
+{
+    return {
+        { QStringLiteral("Alpha"), 1, 2.5, true },
+        { QStringLiteral("beta"), 2, 4.0, false },
+        { QStringLiteral("Gamma"), 3, 3.5, true },
+        { QStringLiteral("delta"), 4, 1.0, false }
+    };
+}
+
+void TestQueryParser::evaluator_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<QStringList>("expectedNames");
+
+    QTest::newRow("> int") << "number>2" << QStringList({"Gamma", "delta"});
+    QTest::newRow("!= int") << "number!=2" << QStringList({"Alpha", "Gamma", "delta"});
+    QTest::newRow("= float on int") << "number=2.0" << QStringList({"beta"});
+    QTest::newRow("<= float") << "rating<=2.5" << QStringList({"Alpha", "delta"});
+    QTest::newRow("= string") << "name='beta'" << QStringList({"beta"});
+    QTest::newRow("= string case") << "name='Beta'" << QStringList();
+    QTest::newRow("~= string") << "name~='ALPHA'" << QStringList({"Alpha"});
+    QTest::newRow("~= wildcard") << "name~='*TA'" << QStringList({"beta", "delta"});
+    QTest::newRow("= bool") << "favorite=1" << QStringList({"Alpha", "Gamma"});
+    QTest::newRow("and") << "favorite=1 & rating>3" << QStringList({"Gamma"});
+    QTest::newRow("or") << "number<2 | number>3" << QStringList({"Alpha", "delta"});
+    QTest::newRow("negated scope") << "!(number>2)" << QStringList({"Alpha", "beta"});
+    QTest::newRow("nested") << "name~='*a' & !(number=1 | rating<2)" << QStringList({"beta", "Gamma"});
+    QTest::newRow("order descending") << "number>0 [\\rating]" << QStringList({"beta", "Gamma", "Alpha", "delta"});
+    QTest::newRow("order ascending") << "number>1 [/name]" << QStringList({"Gamma", "beta", "delta"});
+    QTest::newRow("order multiple") << "number>0 [\\favorite][/rating]" << QStringList({"Alpha", "Gamma", "delta", "beta"});
+}
+
+void TestQueryParser::evaluator()
+{
+    QFETCH(QString, query);
+    QFETCH(QStringList, expectedNames);
+
+    QIviQueryParser parser;
+    parser.setQuery(query);
+    QScopedPointer<QIviAbstractQueryTerm> term(parser.parse());
+    QVERIFY2(term, qPrintable(parser.lastError()));
+
+    QIviQueryTermEvaluator evaluator(&EvaluatorItem::staticMetaObject, term.data(), parser.orderTerms());
+    QVERIFY2(evaluator.isValid(), qPrintable(evaluator.errorString()));
+
+    // The evaluator doesn't depend on the terms anymore
+    term.reset();
+
+    QList<EvaluatorItem> items = evaluator.filter(evaluatorItems());
+    evaluator.sort(items);
+    QStringList names;
+    for (const EvaluatorItem &item : qAsConst(items))
+        names.append(item.m_name);
+    QCOMPARE(names, expectedNames);
+
+    // The same rows wrapped in QVariants
+    QList<QVariant> variants;
+    for (const EvaluatorItem &item : evaluatorItems())
+        variants.append(QVariant::fromValue(item));
+    variants = evaluator.filter(variants);
+    evaluator.sort(variants);
+    names.clear();
+    for (const QVariant &variant : qAsConst(variants))
+        names.append(variant.value<EvaluatorItem>().m_name);
+    QCOMPARE(names, expectedNames);
+
+    // Variants holding other types never match
+    QVERIFY(!evaluator.matches(QVariant(5)));
+}
+
+void TestQueryParser::invalidEvaluator()
+{
+    QIviQueryParser parser;
+    parser.setQuery(QStringLiteral("unknown=5"));
+    QScopedPointer<QIviAbstractQueryTerm> term(parser.parse());
+    QVERIFY(term);
+
+    QIviQueryTermEvaluator evaluator(&EvaluatorItem::staticMetaObject, term.data());
+    QVERIFY(!evaluator.isValid());
+    QCOMPARE(evaluator.errorString(), QStringLiteral("EvaluatorItem doesn't have a property called unknown"));
+    QVERIFY(evaluator.filter(evaluatorItems()).isEmpty());
+
+    parser.setQuery(QStringLiteral("number='five'"));
+    term.reset(parser.parse());
+    QVERIFY(term);
+    evaluator = QIviQueryTermEvaluator(&EvaluatorItem::staticMetaObject, term.data());
+    QVERIFY(!evaluator.isValid());
+    QCOMPARE(evaluator.errorString(), QStringLiteral("The value five can't be compared with the property number"));
+
+    // Without a term all rows match
+    evaluator = QIviQueryTermEvaluator(&EvaluatorItem::staticMetaObject, nullptr);
+    QVERIFY(evaluator.isValid());
+    QCOMPARE(evaluator.filter(evaluatorItems()).count(), 4);
+    QVERIFY(!QIviQueryTermEvaluator().isValid());
+}
+
+void TestQueryParser::benchmark_data()
+{
+    QTest::addColumn<QString>("query");
+    QTest::addColumn<bool>("inPlace");
+
+    const QString shortQuery = QStringLiteral("artistName~='Sade' & rating>=3.5 [/albumName][/trackNumber]");
+
+    //Needs more than the first block of the arena
+    QStringList clauses;
+    for (int i = 0; i < 32; ++i)
+        clauses.append(QStringLiteral("(genre~='Genre %1' & year>%2 | !rating<=%3.5)").arg(i).arg(1970 + i).arg(i % 5));
+    const QString longQuery = clauses.join(QLatin1String(" | ")) + QLatin1String(" [\\year]");
+
+    QTest::newRow("short query, flex and heap") << shortQuery << false;
+    QTest::newRow("short query, in place and arena") << shortQuery << true;
+    QTest::newRow("long query, flex and heap") << longQuery << false;
+    QTest::newRow("long query, in place and arena") << longQuery << true;
+}
+
+void TestQueryParser::benchmark()
+{
+    QFETCH(QString, query);
+    QFETCH(bool, inPlace);
+
+    QIviQueryParser parser;
+    parser.setQuery(query);
+    QScopedPointer<QIviAbstractQueryTerm> expected(parser.parse());
+    QVERIFY2(expected, qPrintable(parser.lastError()));
+    QSharedPointer<QIviAbstractQueryTerm> inPlaceTerm = parser.parse(QStringView(query));
+    QVERIFY2(inPlaceTerm, qPrintable(parser.lastError()));
+    QCOMPARE(inPlaceTerm->toString(), expected->toString());
+    QCOMPARE(parser.orderTerms().count(), query.count(QLatin1Char('[')));
+
+    if (inPlace) {
+        QBENCHMARK {
+            parser.parse(QStringView(query));
+        }
+    } else {
+        QBENCHMARK {
+            delete parser.parse();
+        }
+    }
 }
 
 //TODO add autotests for the orderTerms
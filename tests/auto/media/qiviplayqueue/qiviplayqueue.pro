@@ -0,0 +1,10 @@
+QT       += testlib ivicore ivimedia ivimedia-private
+
+TARGET = tst_qiviplayqueue
+QMAKE_PROJECT_NAME = $$TARGET
+CONFIG   += testcase
+
+TEMPLATE = app
+
+SOURCES += \
+    tst_qiviplayqueue.cpp
@@ -0,0 +1,296 @@
+/****************************************************************************
+**
+** Copyright (C) 2019 Luxoft Sweden AB
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtIvi module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT-QTAS$
+** Commercial License Usage
+** Licensees holding valid commercial Qt Automotive Suite licenses may use
+** this file in accordance with the commercial license agreement provided
+** with the Software or, alternatively, in accordance with the terms
+** contained in a written agreement between you and The Qt Company.  For
+** licensing terms and conditions see https://www.qt.io/terms-conditions.
+** For further information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest>
+#include <QIviServiceManager>
+#include <QIviServiceObject>
+#include <QIviMediaPlayer>
+#include <QIviMediaPlayerBackendInterface>
+#include <QIviPlayQueue>
+#include <QIviPlayableItem>
+
+class TestBackend : public QIviMediaPlayerBackendInterface
+{
+    Q_OBJECT
+
+public:
+    //Adds very simple Data which can be used for most of the unit tests
+    void initializeSimpleData()
+    {
+        m_list.clear();
+        for (int i = 0; i < 100; i++) {
+            QIviPlayableItem item;
+            item.setId(QLatin1String("simple ") + QString::number(i));
+            m_list.append(QVariant::fromValue(item));
+        }
+    }
+
+    void initialize() override
+    {
+        emit canReportCountChanged(true);
+        emit initializationDone();
+    }
+
+    void play() override {}
+    void pause() override {}
+    void stop() override {}
+    void seek(qint64 offset) override { Q_UNUSED(offset) }
+    void next() override {}
+    void previous() override {}
+    void setPlayMode(QIviMediaPlayer::PlayMode playMode) override { Q_UNUSED(playMode) }
+    void setPosition(qint64 position) override { Q_UNUSED(position) }
+    void setCurrentIndex(int currentIndex) override { Q_UNUSED(currentIndex) }
+    void setVolume(int volume) override { Q_UNUSED(volume) }
+    void setMuted(bool muted) override { Q_UNUSED(muted) }
+
+    //Replies to every fetch without any rows, like a backend which failed to load them
+    void setEmptyReplies(bool emptyReplies)
+    {
+        m_emptyReplies = emptyReplies;
+    }
+
+    void fetchData(const QUuid &identifier, int start, int count) override
+    {
+        emit countChanged(m_list.count());
+        const QList<QVariant> items = m_emptyReplies ? QList<QVariant>() : m_list.mid(start, count);
+        emit dataFetched(identifier, items, start, start + items.count() < m_list.count());
+    }
+
+    void insert(int index, const QVariant &item) override
+    {
+        Q_UNUSED(index)
+        Q_UNUSED(item)
+    }
+
+    void remove(int index) override
+    {
+        Q_UNUSED(index)
+    }
+
+    void move(int currentIndex, int newIndex) override
+    {
+        Q_UNUSED(currentIndex)
+        Q_UNUSED(newIndex)
+    }
+
+private:
+    QList<QVariant> m_list;
+    bool m_emptyReplies = false;
+};
+
+class TestServiceObject : public QIviServiceObject
+{
+    Q_OBJECT
+
+public:
+    explicit TestServiceObject(QObject *parent = nullptr) :
+        QIviServiceObject(parent)
+    {
+        m_backend = new TestBackend;
+        m_interfaces << QIviMediaPlayer_iid;
+    }
+
+    QStringList interfaces() const { return m_interfaces; }
+    QIviFeatureInterface *interfaceInstance(const QString &interface) const
+    {
+        if (interface == QIviMediaPlayer_iid)
+            return testBackend();
+        else
+            return 0;
+    }
+
+    TestBackend *testBackend() const
+    {
+        return m_backend;
+    }
+
+private:
+    QStringList m_interfaces;
+    TestBackend *m_backend;
+};
+
+static QString itemId(QIviPlayQueue *queue, int row)
+{
+    return queue->get(row).value<QIviPlayableItem>().id();
+}
+
+class tst_QIviPlayQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_QIviPlayQueue();
+
+private Q_SLOTS:
+    void cleanup();
+
+    void testCacheLimit();
+    void testCacheLimit_fetchMore();
+    void testEmptyReply();
+
+private:
+    QIviServiceManager *manager;
+};
+
+tst_QIviPlayQueue::tst_QIviPlayQueue()
+    : manager(QIviServiceManager::instance())
+{
+}
+
+void tst_QIviPlayQueue::cleanup()
+{
+    manager->unloadAllBackends();
+}
+
+void tst_QIviPlayQueue::testCacheLimit()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    QIviMediaPlayer player;
+    QIviPlayQueue *queue = player.playQueue();
+    queue->setChunkSize(10);
+    queue->setFetchMoreThreshold(0);
+
+    QSignalSpy cacheLimitSpy(queue, &QIviPlayQueue::cacheLimitChanged);
+    queue->setCacheLimit(2);
+    QCOMPARE(queue->cacheLimit(), 2);
+    QCOMPARE(cacheLimitSpy.count(), 1);
+
+    player.setServiceObject(service);
+    queue->setLoadingType(QIviPlayQueue::DataChanged);
+    QCOMPARE(queue->rowCount(), 100);
+    QCOMPARE(itemId(queue, 5), QLatin1String("simple 5"));
+
+    // The second chunk isn't cached yet and needs to be fetched first
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    QVERIFY(!queue->get(15).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(itemId(queue, 15), QLatin1String("simple 15"));
+    QCOMPARE(fetchDataSpy.count(), 1);
+
+    // Fetching a third chunk evicts the least recently used one
+    QVERIFY(!queue->get(25).isValid());
+    QCOMPARE(itemId(queue, 25), QLatin1String("simple 25"));
+    QCOMPARE(fetchDataSpy.count(), 2);
+
+    QCOMPARE(itemId(queue, 15), QLatin1String("simple 15"));
+    QCOMPARE(fetchDataSpy.count(), 2);
+
+    // The evicted chunk is fetched again on the next access
+    fetchDataSpy.clear();
+    QVERIFY(!queue->get(5).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(itemId(queue, 5), QLatin1String("simple 5"));
+
+    // Lowering the limit evicts the chunks immediately
+    queue->setCacheLimit(1);
+    fetchDataSpy.clear();
+    QVERIFY(!queue->get(25).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(itemId(queue, 25), QLatin1String("simple 25"));
+
+    // A new chunk size keeps the rows which are loaded
+    queue->setCacheLimit(0);
+    queue->get(5);
+    queue->get(15);
+    queue->setChunkSize(20);
+    fetchDataSpy.clear();
+    QCOMPARE(itemId(queue, 15), QLatin1String("simple 15"));
+    QVERIFY(!fetchDataSpy.count());
+}
+
+void tst_QIviPlayQueue::testCacheLimit_fetchMore()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    QIviMediaPlayer player;
+    QIviPlayQueue *queue = player.playQueue();
+    queue->setChunkSize(10);
+    queue->setFetchMoreThreshold(0);
+    queue->setCacheLimit(2);
+    player.setServiceObject(service);
+    QCOMPARE(queue->rowCount(), 10);
+
+    queue->fetchMore(QModelIndex());
+    queue->fetchMore(QModelIndex());
+    QCOMPARE(queue->rowCount(), 30);
+
+    // The first chunk got evicted, but its rows are kept
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    QVERIFY(!queue->get(5).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QCOMPARE(fetchDataSpy.at(0).at(2).toInt(), 0);
+    QCOMPARE(itemId(queue, 5), QLatin1String("simple 5"));
+
+    // Fetching it again doesn't change the rows or whether more data is available
+    QCOMPARE(queue->rowCount(), 30);
+    QVERIFY(queue->canFetchMore(QModelIndex()));
+    queue->fetchMore(QModelIndex());
+    QCOMPARE(queue->rowCount(), 40);
+    QCOMPARE(itemId(queue, 35), QLatin1String("simple 35"));
+}
+
+void tst_QIviPlayQueue::testEmptyReply()
+{
+    TestServiceObject *service = new TestServiceObject();
+    manager->registerService(service, service->interfaces());
+    service->testBackend()->initializeSimpleData();
+
+    QIviMediaPlayer player;
+    QIviPlayQueue *queue = player.playQueue();
+    queue->setChunkSize(10);
+    queue->setFetchMoreThreshold(0);
+    player.setServiceObject(service);
+    queue->setLoadingType(QIviPlayQueue::DataChanged);
+    QCOMPARE(queue->rowCount(), 100);
+
+    // The backend replies without any rows
+    QSignalSpy fetchDataSpy(service->testBackend(), SIGNAL(dataFetched(const QUuid &, const QList<QVariant> &, int , bool )));
+    service->testBackend()->setEmptyReplies(true);
+    QVERIFY(!queue->get(15).isValid());
+    QCOMPARE(fetchDataSpy.count(), 1);
+    QVERIFY(fetchDataSpy.at(0).at(1).toList().isEmpty());
+    QVERIFY(!queue->get(15).isValid());
+    QCOMPARE(fetchDataSpy.count(), 2);
+
+    // The chunk is still requested on the next access
+    service->testBackend()->setEmptyReplies(false);
+    QVERIFY(!queue->get(15).isValid());
+    QCOMPARE(fetchDataSpy.count(), 3);
+    QCOMPARE(itemId(queue, 15), QLatin1String("simple 15"));
+    QCOMPARE(fetchDataSpy.count(), 3);
+}
+
+QTEST_MAIN(tst_QIviPlayQueue)
+
+#include "tst_qiviplayqueue.moc"